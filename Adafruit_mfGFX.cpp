@@ -66,6 +66,7 @@ void Adafruit_GFX::setFont(uint8_t f) {
       fontData = timesNewRoman_8ptBitmaps;
 	  fontDesc = timesNewRoman_8ptDescriptors;
       fontKern = 1;
+      fontPacking = FONT_RLE;
       break;
 #endif
 #ifdef CENTURYGOTHIC8
@@ -73,6 +74,7 @@ void Adafruit_GFX::setFont(uint8_t f) {
       fontData = centuryGothic_8ptBitmaps;
 	  fontDesc = centuryGothic_8ptDescriptors;
       fontKern = 1;
+      fontPacking = FONT_ROWS;
       break;
 #endif
 #ifdef ARIAL8
@@ -80,6 +82,7 @@ void Adafruit_GFX::setFont(uint8_t f) {
       fontData = arial_8ptBitmaps;
 	  fontDesc = arial_8ptDescriptors;
       fontKern = 1;
+      fontPacking = FONT_ROWS;
       break;
 #endif
 #ifdef COMICSANSMS8
@@ -87,6 +90,7 @@ void Adafruit_GFX::setFont(uint8_t f) {
       fontData = comicSansMS_8ptBitmaps;
 	  fontDesc = comicSansMS_8ptDescriptors;
       fontKern = 1;
+      fontPacking = FONT_ROWS;
       break;
 #endif
 #ifdef GLCDFONTDEFAULT
@@ -94,6 +98,23 @@ void Adafruit_GFX::setFont(uint8_t f) {
       fontData = glcdfontBitmaps;
 	  fontDesc = glcdfontDescriptors;
       fontKern = 1;
+      fontPacking = FONT_ROWS;
+      break;
+#endif
+#ifdef TINY3X5
+    case FONT_3X5:
+      fontData = font3x5Bitmaps;
+	  fontDesc = font3x5Descriptors;
+      fontKern = 1;
+      fontPacking = FONT_BITS;
+      break;
+#endif
+#ifdef TINY5X5
+    case FONT_5X5:
+      fontData = font5x5Bitmaps;
+	  fontDesc = font5x5Descriptors;
+      fontKern = 1;
+      fontPacking = FONT_BITS;
       break;
 #endif
 #ifdef TESTFONT
@@ -101,6 +122,7 @@ void Adafruit_GFX::setFont(uint8_t f) {
       fontData = testBitmaps;
 	  fontDesc = testDescriptors;
       fontKern = 1;
+      fontPacking = FONT_ROWS;
       break;
 #endif
 	default:
@@ -108,6 +130,7 @@ void Adafruit_GFX::setFont(uint8_t f) {
       fontData = glcdfontBitmaps;
 	  fontDesc = glcdfontDescriptors;
       fontKern = 1;
+      fontPacking = FONT_ROWS;
       break;
   }
 
@@ -436,8 +459,9 @@ size_t Adafruit_GFX::write(uint8_t c) {
     // skip em
   } else {
     drawFastChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
-	uint16_t w = fontDesc[c-fontStart].width;
-	uint16_t h = fontDesc[c-fontStart].height;
+	uint8_t g = (c < fontStart || c > fontEnd) ? 0 : c - fontStart;	// As drawChar()
+	uint16_t w = fontDesc[g].width;
+	uint16_t h = fontDesc[g].height;
     if (fontKern > 0 && textcolor != textbgcolor) {
       fillRect(cursor_x+w*textsize,cursor_y,fontKern*textsize,h*textsize,textbgcolor);
     }
@@ -473,16 +497,12 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
      ((y + (fontDesc[c].height * size) - 1) < 0))   // Clip top
     return;
 
-	uint8_t bitCount=0;
-  	uint16_t fontIndex = fontDesc[c].offset + 2; //((fontDesc + c)->offset) + 2;
+  GlyphCursor glyph;
+  glyphBegin(glyph, c);
   
   for (int8_t i=0; i<fontDesc[c].height; i++ ) {	// i<fontHeight
-    uint8_t line = 0;
     for (int8_t j = 0; j<fontDesc[c].width; j++) {			//j<fontWidth
-      if (bitCount++%8 == 0) {
-        line = fontData[fontIndex++];
-      }
-      if (line & 0x80) {
+      if (glyphPixel(glyph)) {
         if (size == 1) {// default sizeFast
           drawPixel(x+j, y+i, color);
           }
@@ -496,9 +516,8 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
           fillRect(x+j*size, y+i*size, size, size, bg);
         }
       }
-      line <<= 1;
     }
-    bitCount = 0;
+    glyphRowEnd(glyph);
   }
 }
 
@@ -530,6 +549,28 @@ uint8_t Adafruit_GFX::getRotation(void) {
   return rotation;
 }
 
+// The text settings, so code that changes them for a moment can put the
+// caller's back
+uint8_t Adafruit_GFX::getFont(void) {
+  return font;
+}
+
+uint8_t Adafruit_GFX::getTextSize(void) {
+  return textsize;
+}
+
+uint16_t Adafruit_GFX::getTextColor(void) {
+  return textcolor;
+}
+
+uint16_t Adafruit_GFX::getTextBgColor(void) {
+  return textbgcolor;
+}
+
+boolean Adafruit_GFX::getTextWrap(void) {
+  return wrap;
+}
+
 void Adafruit_GFX::setRotation(uint8_t x) {
   rotation = (x & 3);
   switch(rotation) {
@@ -63,7 +63,14 @@ class Adafruit_GFX : public Print {
     height(void),
     width(void);
 
-  uint8_t getRotation(void);
+  uint8_t
+    getRotation(void),
+    getFont(void),
+    getTextSize(void);
+  uint16_t
+    getTextColor(void),
+    getTextBgColor(void);
+  boolean getTextWrap(void);
 
  protected:
   const int16_t
@@ -78,13 +85,55 @@ class Adafruit_GFX : public Print {
     rotation,
     font,
     fontStart,
-    fontEnd;
+    fontEnd,
+    fontPacking;
   int8_t
     fontKern;
   const uint8_t* fontData;
   const FontDescriptor* fontDesc;
   boolean
     wrap; // If set, 'wrap' text at right edge of display
+
+  // Glyph decoder shared by drawChar() and subclass text fast paths.
+  // glyphBegin() takes a glyph index (c - fontStart); glyphPixel() then
+  // returns the glyph's pixels left to right, and glyphRowEnd() must be
+  // called after each row of fontDesc[c].width pixels.
+  struct GlyphCursor {
+    uint16_t index;	// Next byte of fontData
+    uint8_t  count,	// Bits (or RLE nibbles) consumed
+             line,	// Current byte, next pixel in bit 7
+             run;	// RLE pixels left in the current run
+    boolean  rle, ink;
+  };
+
+  void glyphBegin(GlyphCursor &g, uint8_t c) {
+    g.index = (fontDesc[c].offset & ~FONT_RLE_GLYPH) + 2;
+    g.count = g.line = g.run = 0;
+    g.rle   = (fontPacking == FONT_RLE) && (fontDesc[c].offset & FONT_RLE_GLYPH);
+    g.ink   = true;
+  }
+
+  boolean glyphPixel(GlyphCursor &g) {
+    if (g.rle) {	// Next run, decoded as it's reached
+      while (g.run == 0) {
+        g.ink = !g.ink;
+        g.run = (g.count++ & 1) ? fontData[g.index++] & 0x0F
+                                : fontData[g.index] >> 4;
+      }
+      g.run--;
+      return g.ink;
+    }
+    if (g.count++ % 8 == 0) {
+      g.line = fontData[g.index++];
+    }
+    boolean set = g.line & 0x80;
+    g.line <<= 1;
+    return set;
+  }
+
+  void glyphRowEnd(GlyphCursor &g) {
+    if (fontPacking == FONT_ROWS) g.count = 0;	// FONT_BITS rows run on
+  }
 };
 
 #endif // _ADAFRUIT_GFX_H
\ No newline at end of file
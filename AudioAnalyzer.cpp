@@ -0,0 +1,167 @@
+/*
+ Background music analysis, see AudioAnalyzer.h.
+*/
+
+#include "AudioAnalyzer.h"
+#include "window.h"
+
+#define FLUX_FLOOR       8       // Flux an onset needs over the average
+#define ONSET_HOLDOFF    100     // ms; no onsets closer together
+#define TEMPO_MIN_MS     400     // Beat periods are folded into
+#define TEMPO_MAX_MS     800     // 400 - 800 ms, 150 - 75 bpm
+#define TEMPO_HITS       4       // Agreeing intervals before bpm() reports
+#define TEMPO_TIMEOUT    3000    // ms without an onset before it stops
+#define CREDIT_MAX       20000L  // us; how much unused budget can be saved
+
+AudioAnalyzer::AudioAnalyzer(AudioSampler &sampler) : sampler(sampler) {
+  spectrumLogMap(edges, ANALYZER_BANDS, 1, SPECTRUM_POINTS / 2);
+  memset(bands, 0, sizeof(bands));
+  budget       = 100;
+  period       = 0;
+  hits         = 0;
+  onsetFlag    = false;
+  onsetTime    = 0;
+  measuredLoad = 0;
+}
+
+boolean AudioAnalyzer::begin(uint16_t rate) {
+  if((sampler.getBlockSize() > SPECTRUM_POINTS) ||
+     (SPECTRUM_POINTS % sampler.getBlockSize())) return false;
+
+  history.reset();
+  fresh        = 0;
+
+  memset(prev , 0, sizeof(prev));
+  memset(bands, 0, sizeof(bands));
+  for(uint8_t b=0; b<ANALYZER_BANDS; b++) bandPeak[b] = 8;
+  flux.reset();
+  period       = 0;
+  misses       = hits = 0;
+  onsetFlag    = false;
+  onsetTime    = millis();
+  lastMicros   = micros();
+  busyMicros   = spanMicros = 0;
+  measuredLoad = 0;
+  credit       = 0;
+  return sampler.begin(rate);
+}
+
+void AudioAnalyzer::end(void) {
+  sampler.end();
+}
+
+// 'permille' of the CPU, averaged over time; e.g. 100 = 10%
+void AudioAnalyzer::setBudget(uint16_t permille) {
+  budget = (permille > 1000) ? 1000 : permille;
+}
+
+boolean AudioAnalyzer::update(void) {
+  const uint16_t *samples;
+  uint32_t        now = micros(), elapsed = now - lastMicros, spent;
+
+  lastMicros  = now;
+  spanMicros += elapsed;
+  if(elapsed > 100000UL) elapsed = 100000UL;  // Keeps the product in range
+  // Credit is kept in ns: in us, the share of a caller that comes back
+  // every few us would round down to nothing
+  credit += (int32_t)(elapsed * budget);
+  if(credit > CREDIT_MAX * 1000) credit = CREDIT_MAX * 1000;
+
+  if(spanMicros >= 1000000UL) {               // Roughly once a second
+    measuredLoad = busyMicros / (spanMicros / 1000);
+    busyMicros   = spanMicros = 0;
+  }
+
+  if((samples = sampler.read()) == NULL) return false;
+  history.add(samples, sampler.getBlockSize());
+  sampler.release();                          // Copied, the timer can have it
+  fresh += sampler.getBlockSize();
+  if((fresh < SPECTRUM_POINTS) || !history.full()) return false;
+  if(credit <= 0) return false;               // Over budget, skip
+
+  fresh = 0;
+  analyse();
+
+  spent       = micros() - now;
+  credit     -= (int32_t)spent * 1000;
+  busyMicros += spent;
+  return true;
+}
+
+void AudioAnalyzer::analyse(void) {
+  int16_t  levels[ANALYZER_BANDS];
+  uint32_t rise = 0, now, threshold;
+  uint16_t f, average, ioi;
+  uint8_t  i;
+
+  // Magnitudes of bins 1 - 63 (in the spectrum display's units) and
+  // how much they rose since the last block
+  history.magnitudes(data, WINDOW_HANN);
+  for(i=1; i<SPECTRUM_POINTS/2; i++) {
+    if(data[i] > prev[i]) rise += data[i] - prev[i];
+    prev[i] = data[i];
+  }
+
+  spectrumColumns(data, edges, ANALYZER_BANDS, levels);
+  for(i=0; i<ANALYZER_BANDS; i++) {
+    if(levels[i] > bandPeak[i]) bandPeak[i] = levels[i];
+    else if(bandPeak[i] > 8)    bandPeak[i] -= (bandPeak[i] >> 6) + 1;
+    bands[i] = ((uint32_t)levels[i] * 255) / bandPeak[i];
+  }
+
+  // Onset: flux half again over its recent average.  The threshold is
+  // 32 bits wide, it passes 0xFFFF when the flux is loud
+  f         = (rise > 0xFFFF) ? 0xFFFF : rise;
+  average   = flux.average();
+  threshold = (uint32_t)average + (average >> 1) + FLUX_FLOOR;
+  flux.push(f);
+  now       = millis();
+  if((flux.size() < 16) || (f < threshold) ||
+     (now - onsetTime < ONSET_HOLDOFF)) return;
+
+  // Tempo from the interval since the last onset, folded into range
+  ioi       = (now - onsetTime > 0xFFFF) ? 0 : now - onsetTime;
+  onsetTime = now;
+  onsetFlag = true;
+  if(ioi == 0) return;
+  while(ioi > TEMPO_MAX_MS) ioi >>= 1;
+  while(ioi < TEMPO_MIN_MS) ioi <<= 1;
+
+  if(period && (abs((int32_t)ioi - period) < (period >> 2))) {
+    period = (period * 3 + ioi) >> 2;
+    misses = 0;
+    if(hits < TEMPO_HITS) hits++;
+  } else if(!period || (++misses >= TEMPO_HITS)) {
+    period = ioi;                              // Start over on this one
+    misses = hits = 0;
+  }
+}
+
+boolean AudioAnalyzer::onset(void) {
+  boolean o = onsetFlag;
+  onsetFlag = false;
+  return o;
+}
+
+uint8_t AudioAnalyzer::band(uint8_t b) {
+  return (b < ANALYZER_BANDS) ? bands[b] : 0;
+}
+
+uint8_t AudioAnalyzer::level(void) {
+  uint8_t l = 0;
+  for(uint8_t b=0; b<ANALYZER_BANDS; b++) if(bands[b] > l) l = bands[b];
+  return l;
+}
+
+uint16_t AudioAnalyzer::bpm(void) {
+  if((hits < TEMPO_HITS) || (millis() - onsetTime > TEMPO_TIMEOUT)) return 0;
+  return 60000UL / period;
+}
+
+uint16_t AudioAnalyzer::load(void) {
+  return measuredLoad;
+}
+
+uint32_t AudioAnalyzer::lastOnset(void) {
+  return onsetTime;
+}
@@ -0,0 +1,70 @@
+#ifndef _AUDIOANALYZER_H
+#define _AUDIOANALYZER_H
+
+#include "application.h"
+#include "AudioSampler.h"
+#include "RollingStats.h"
+#include "spectrum.h"
+
+// Music analysis for the modes that are not the spectrum display: takes
+// blocks from an AudioSampler, transforms them (Hann window, 128 point
+// fix_fftr()) and keeps
+//
+//   - band energies: ANALYZER_BANDS log spaced bands, each auto-gained
+//     to 0 - 255 against its own slowly decaying peak
+//   - onsets: spectral flux (the summed rise of every bin since the last
+//     block) well above its recent average
+//   - tempo: the smoothed interval between onsets, folded into 75 - 150
+//     beats per minute
+//
+// update() does the work and is meant to be called from a mode's frame
+// loop as often as it likes; the queries just return what the last
+// analysis found.  Analysis is rate limited to a CPU budget (10% by
+// default): while the time it has spent is over budget, update() only
+// keeps the newest samples and skips the transform.  load() reports the
+// measured share.
+
+#define ANALYZER_BANDS	4		// bass, low mid, high mid, treble
+
+class AudioAnalyzer {
+
+ public:
+
+  // The sampler's block size must divide SPECTRUM_POINTS (128); blocks
+  // are collected until there are SPECTRUM_POINTS new samples to analyse
+  AudioAnalyzer(AudioSampler &sampler);
+
+  boolean
+    begin(uint16_t rate),      // Start the sampler; false if it can't
+    update(void),              // Analyse a block if due; true if it did
+    onset(void);               // Onset since the last call?
+  void
+    end(void),                 // Stop the sampler
+    setBudget(uint16_t permille);
+  uint8_t
+    band(uint8_t b),           // 0 - 255, b < ANALYZER_BANDS
+    level(void);               // Loudest band
+  uint16_t
+    bpm(void),                 // 0 until a tempo has been held a while
+    load(void);                // Measured CPU share, per mille
+  uint32_t
+    lastOnset(void);           // millis() of the last onset
+
+ private:
+
+  void analyse(void);
+
+  AudioSampler &sampler;
+  SpectrumHistory history;
+  int16_t       data[SPECTRUM_POINTS],     // FFT buffer, then magnitudes
+                prev[SPECTRUM_POINTS / 2]; // Last block's magnitudes
+  uint16_t      edges[ANALYZER_BANDS + 1], bandPeak[ANALYZER_BANDS],
+                period, budget, measuredLoad, fresh;
+  uint8_t       bands[ANALYZER_BANDS], misses, hits;
+  boolean       onsetFlag;
+  uint32_t      onsetTime, lastMicros, busyMicros, spanMicros;
+  int32_t       credit;                    // Nanoseconds we may still use
+  RollingStats<uint16_t, 16> flux;         // Last ~quarter second at 8kHz
+};
+
+#endif // _AUDIOANALYZER_H
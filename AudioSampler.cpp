@@ -0,0 +1,142 @@
+/*
+ Timer-driven, double-buffered audio sampling, see AudioSampler.h.
+*/
+
+#include "SparkIntervalTimer.h"
+#include "AudioSampler.h"
+
+#define NO_BLOCK 0xFF
+
+IntervalTimer sampleTimer;
+
+static AudioSampler *activeSampler = NULL;
+
+static void sampleISR(void) {
+  activeSampler->sample();
+}
+
+AudioSampler::AudioSampler(uint8_t pin, uint16_t blockSize) {
+  this->pin       = pin;
+  this->blockSize = blockSize;
+  buffer          = (uint16_t *)malloc(blockSize * 2 * sizeof(uint16_t));
+  rate            = 0;
+  running         = false;
+  source          = NULL;
+  fillBlock       = 0;
+  fillIndex       = 0;
+  readyBlock      = NO_BLOCK;
+  heldBlock       = NO_BLOCK;
+  dropped         = 0;
+}
+
+AudioSampler::~AudioSampler(void) {
+  end();
+  if(buffer) free(buffer);
+}
+
+// Returns false if the buffers could not be allocated or the rate is out
+// of the timer's range.  Calling begin() again while running just
+// changes the rate.
+boolean AudioSampler::begin(uint16_t rate) {
+  intPeriod period;
+
+  if(!buffer || (rate < 16)) return false;
+  period = 1000000UL / rate;                // Timer period in microseconds
+
+  if(running && (activeSampler == this)) {
+    if(rate != this->rate) sampleTimer.resetPeriod_SIT(period, uSec);
+    this->rate = rate;
+    return true;
+  }
+
+  end();
+  fillBlock  = 0;
+  fillIndex  = 0;
+  readyBlock = NO_BLOCK;
+  heldBlock  = NO_BLOCK;
+  dropped    = 0;
+  this->rate = rate;
+
+  activeSampler = this;
+  if(!sampleTimer.begin(sampleISR, period, uSec)) return false;
+  running = true;
+  return true;
+}
+
+void AudioSampler::end(void) {
+  if(!running) return;
+  sampleTimer.end();
+  running = false;
+}
+
+void AudioSampler::setSource(Source source) {
+  this->source = source;
+}
+
+// Timer interrupt.  A full block becomes the ready one, replacing any
+// unread ready block, and filling moves to the other block.  If the
+// reader still holds that one, sampling pauses until release() or
+// read() lets it go.
+void AudioSampler::sample(void) {
+  uint8_t other;
+
+  if(fillBlock == NO_BLOCK) return;          // Paused, no free block
+  buffer[fillBlock * blockSize + fillIndex] =
+    source ? source(pin) : analogRead(pin);
+  if(++fillIndex < blockSize) return;
+
+  fillIndex = 0;
+  other     = 1 - fillBlock;
+  if(readyBlock != NO_BLOCK) dropped++;      // Reader missed a block
+  readyBlock = fillBlock;
+  if(other == heldBlock) {
+    fillBlock = NO_BLOCK;
+    dropped++;                               // Samples are lost from here
+  } else {
+    fillBlock = other;
+  }
+}
+
+// Returns the most recent full block, or NULL if no block has been
+// completed since the last call.  Any block still held from the last
+// call is released.  The block returned is not written by the timer
+// until release() or read() is called again.
+const uint16_t *AudioSampler::read(void) {
+  uint8_t block;
+
+  noInterrupts();
+  block      = readyBlock;
+  heldBlock  = block;
+  readyBlock = NO_BLOCK;
+  if((block != NO_BLOCK) && (fillBlock == NO_BLOCK)) {
+    fillBlock = 1 - block;                   // Resume into the freed block
+    fillIndex = 0;
+  }
+  interrupts();
+
+  return (block == NO_BLOCK) ? NULL : &buffer[block * blockSize];
+}
+
+// Lets the timer fill the block read() returned again, resuming into it
+// if sampling paused while it was held.
+void AudioSampler::release(void) {
+  noInterrupts();
+  if((heldBlock != NO_BLOCK) && (fillBlock == NO_BLOCK)) {
+    fillBlock = heldBlock;
+    fillIndex = 0;
+  }
+  heldBlock = NO_BLOCK;
+  interrupts();
+}
+
+uint16_t AudioSampler::getRate(void) {
+  return rate;
+}
+
+uint16_t AudioSampler::getBlockSize(void) {
+  return blockSize;
+}
+
+uint16_t AudioSampler::overruns(void) {
+  return dropped;
+}
@@ -0,0 +1,61 @@
+#ifndef _AUDIOSAMPLER_H
+#define _AUDIOSAMPLER_H
+
+#include "application.h"
+
+// Timer-driven audio capture.  A SparkIntervalTimer slot reads the ADC at
+// a fixed rate into one of two sample blocks; when a block is full it is
+// handed to the reader and the timer moves on to the other one, so the
+// renderer can take its time over a block (FFT, drawing, Spark.process())
+// without the sample rate changing under it.  Bins of a transform over a
+// block then map to fixed frequencies: bin k = k * rate / blockSize Hz.
+//
+// The block being read is never written to until the reader lets it go,
+// with release() or the next read().  Call release() as soon as the
+// block has been copied or used: a reader that holds on to it until it
+// next polls read() pauses sampling whenever it polls less often than
+// about twice a block.  If the reader is slower than the sample rate,
+// unread blocks are replaced by newer ones, or sampling pauses while the
+// reader holds one block and the other is waiting; overruns() counts
+// both.
+//
+// Like RGBmatrixPanel, only one sampler can be running at a time.
+
+class AudioSampler {
+
+ public:
+
+  // Stand-in for analogRead(), e.g. a generated or recorded signal for
+  // deterministic tests.  Called from the timer interrupt.
+  typedef uint16_t (*Source)(uint8_t pin);
+
+  // blockSize samples per block; two blocks are allocated
+  AudioSampler(uint8_t pin, uint16_t blockSize=128);
+  ~AudioSampler(void);
+
+  boolean
+    begin(uint16_t rate);      // Start sampling at 'rate' Hz (16 - 65535)
+  void
+    end(void),                 // Stop the timer
+    setSource(Source source),  // NULL = analogRead() of the pin
+    sample(void),              // Take one sample (the timer calls this)
+    release(void);             // Done with the block read() returned
+  const uint16_t
+    *read(void);               // Newest full block, or NULL
+  uint16_t
+    getRate(void),
+    getBlockSize(void),
+    overruns(void);            // Blocks dropped or cut short since begin()
+
+ private:
+
+  uint16_t         *buffer;    // Two blocks of blockSize samples
+  uint16_t          blockSize, rate, fillIndex;
+  volatile uint16_t dropped;
+  volatile uint8_t  fillBlock, readyBlock, heldBlock;
+  uint8_t           pin;
+  boolean           running;
+  Source            source;
+};
+
+#endif // _AUDIOSAMPLER_H
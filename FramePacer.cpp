@@ -0,0 +1,96 @@
+/*
+ Adaptive frame pacing, see FramePacer.h.
+*/
+
+#include "FramePacer.h"
+
+#define PACER_HOLD	8		// Frames to wait after changing scale
+#define PACER_OVER	90		// % of the interval that is over budget
+#define PACER_UNDER	80		// % a finer resolution has to fit in
+
+FramePacer::FramePacer(uint8_t fps) {
+  targetFps = 0;
+  setTarget(fps);
+  frameStart = secondStart = 0;
+  average    = 0;
+  sinceLast  = 0;
+  step       = 1;
+  frames     = achieved = hold = 0;
+}
+
+void FramePacer::begin(void) {
+  frameStart  = micros() - interval;       // First frame is due at once
+  secondStart = micros();
+  average     = 0;
+  sinceLast   = interval / 1000;
+  step        = 1;
+  frames      = achieved = 0;
+  hold        = PACER_HOLD;
+}
+
+void FramePacer::setTarget(uint8_t fps) {
+  if(fps < 1)   fps = 1;
+  if(fps > 100) fps = 100;
+  targetFps = fps;
+  interval  = 1000000UL / fps;
+  hold      = PACER_HOLD;                  // Let the estimate settle
+}
+
+boolean FramePacer::due(void) {
+  uint32_t now = micros(), late = now - frameStart;
+
+  if(late < interval) return false;
+  // A slow frame doesn't make the next ones hurry to catch up
+  sinceLast  = (late > 65535000UL) ? 65535 : late / 1000;
+  frameStart = now;
+  return true;
+}
+
+void FramePacer::done(void) {
+  uint32_t now = micros(), spent = now - frameStart;
+
+  if(now - secondStart >= 1000000UL) {
+    achieved     = frames;
+    frames       = 0;
+    secondStart  = now;
+  }
+  frames++;
+
+  // Smoothed frame time, 1/4 of each new one; restarts after a change
+  if(!average) average = spent;
+  else         average += ((int32_t)spent - (int32_t)average) / 4;
+
+  if(hold) {
+    hold--;
+    return;
+  }
+  if((average > interval / 100 * PACER_OVER) && (step < PACER_MAX_SCALE)) {
+    step   *= 2;
+    average = 0;
+    hold    = PACER_HOLD;
+  } else if((step > 1) && (average * 4 < interval / 100 * PACER_UNDER)) {
+    step   /= 2;
+    average = 0;
+    hold    = PACER_HOLD;
+  }
+}
+
+uint8_t FramePacer::scale(void) {
+  return step;
+}
+
+uint8_t FramePacer::fps(void) {
+  return achieved;
+}
+
+uint8_t FramePacer::target(void) {
+  return targetFps;
+}
+
+uint16_t FramePacer::elapsed(void) {
+  return sinceLast;
+}
+
+uint32_t FramePacer::frameMicros(void) {
+  return average;
+}
@@ -0,0 +1,56 @@
+#ifndef _FRAMEPACER_H
+#define _FRAMEPACER_H
+
+#include "application.h"
+
+// Frame pacing for the animated modes.  A mode's loop asks due() whether
+// it is time for the next frame (otherwise it does its background work,
+// Spark.process() and so on, and asks again), draws the frame and calls
+// done().  The pacer spaces frame starts 1/target seconds apart and
+// times each frame from due() to done().
+//
+// When the smoothed frame time goes over 90% of the frame interval, the
+// mode is asked to render at a lower internal resolution: scale() 2 or 4
+// means compute every scale-th pixel of every scale-th row and fill the
+// block with it.  Once a frame at the next finer resolution would fit
+// in 80% of the interval, counting it as four times the work (more than
+// it really is, as swapping buffers costs the same at any resolution),
+// it steps back up.  After each change the pacer waits a few frames
+// before judging again.
+//
+// elapsed() is the time between the starts of this frame and the last,
+// so animation can move by time rather than by frame and keep its speed
+// whatever rate is achieved.  fps() is the number of frames finished in
+// the last full second.
+
+#define PACER_MAX_SCALE	4		// Coarsest internal resolution, 1/4
+
+class FramePacer {
+
+ public:
+
+  FramePacer(uint8_t fps=30);
+
+  void
+    begin(void),               // Restart timing at full resolution
+    setTarget(uint8_t fps),    // Frames per second to aim for, 1 - 100
+    done(void);                // Frame finished (after swapBuffers())
+  boolean
+    due(void);                 // Start a frame now?
+  uint8_t
+    scale(void),               // 1, 2 or 4: render 1 in scale^2 pixels
+    fps(void),                 // Achieved, over the last second
+    target(void);
+  uint16_t
+    elapsed(void);             // ms since the previous frame's start
+  uint32_t
+    frameMicros(void);         // Smoothed time per frame
+
+ private:
+
+  uint32_t interval, frameStart, secondStart, average;
+  uint16_t sinceLast;
+  uint8_t  targetFps, step, frames, achieved, hold;
+};
+
+#endif // _FRAMEPACER_H
@@ -0,0 +1,115 @@
+/*
+Offscreen canvases for the multifont GFX library, modelled on the
+GFXcanvas classes in later Adafruit_GFX releases.  GFXcanvas444 keeps
+pixels at the RGB matrix's native 4/4/4 depth so RGBmatrixPanel can
+composite it straight into its bit planes.
+*/
+
+#include "GFXcanvas.h"
+
+// Transparency key value no 4/4/4 pixel can ever match
+#define NO_KEY 0xFFFF
+
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+  uint16_t bytes = ((w + 7) / 8) * h;
+  if((buffer = (uint8_t *)malloc(bytes))) {
+    memset(buffer, 0, bytes);
+  }
+}
+
+GFXcanvas1::~GFXcanvas1(void) {
+  if(buffer) free(buffer);
+}
+
+uint8_t *GFXcanvas1::getBuffer(void) {
+  return buffer;
+}
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if(!buffer) return;
+  if((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
+
+  switch(rotation) {
+   case 1:
+    swap(x, y);
+    x = WIDTH  - 1 - x;
+    break;
+   case 2:
+    x = WIDTH  - 1 - x;
+    y = HEIGHT - 1 - y;
+    break;
+   case 3:
+    swap(x, y);
+    y = HEIGHT - 1 - y;
+    break;
+  }
+
+  uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+  if(color) *ptr |=   0x80 >> (x & 7);
+  else      *ptr &= ~(0x80 >> (x & 7));
+}
+
+void GFXcanvas1::fillScreen(uint16_t color) {
+  if(buffer) memset(buffer, color ? 0xFF : 0x00, ((WIDTH + 7) / 8) * HEIGHT);
+}
+
+
+GFXcanvas444::GFXcanvas444(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+  key = 0;
+  if((buffer = (uint16_t *)malloc(w * h * 2))) {
+    memset(buffer, 0, w * h * 2);
+  }
+}
+
+GFXcanvas444::~GFXcanvas444(void) {
+  if(buffer) free(buffer);
+}
+
+uint16_t *GFXcanvas444::getBuffer(void) {
+  return buffer;
+}
+
+// Key is passed as 5/6/5 like every other GFX color, stored as 4/4/4
+void GFXcanvas444::setTransparent(uint16_t c) {
+  key = ((c >> 4) & 0xF00) | ((c >> 3) & 0x0F0) | ((c >> 1) & 0x00F);
+}
+
+// Composite every pixel, black included
+void GFXcanvas444::setOpaque(void) {
+  key = NO_KEY;
+}
+
+uint16_t GFXcanvas444::getTransparent(void) {
+  return key;
+}
+
+void GFXcanvas444::drawPixel(int16_t x, int16_t y, uint16_t c) {
+  if(!buffer) return;
+  if((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
+
+  switch(rotation) {
+   case 1:
+    swap(x, y);
+    x = WIDTH  - 1 - x;
+    break;
+   case 2:
+    x = WIDTH  - 1 - x;
+    y = HEIGHT - 1 - y;
+    break;
+   case 3:
+    swap(x, y);
+    y = HEIGHT - 1 - y;
+    break;
+  }
+
+  // Same truncation as RGBmatrixPanel::drawPixel(): RRRRrGGGGggBBBBb
+  buffer[x + y * WIDTH] = ((c >> 4) & 0xF00) | ((c >> 3) & 0x0F0) |
+                          ((c >> 1) & 0x00F);
+}
+
+void GFXcanvas444::fillScreen(uint16_t c) {
+  if(!buffer) return;
+  uint16_t  p   = ((c >> 4) & 0xF00) | ((c >> 3) & 0x0F0) | ((c >> 1) & 0x00F);
+  uint16_t *ptr = buffer;
+  for(uint16_t i = WIDTH * HEIGHT; i > 0; i--) *ptr++ = p;
+}
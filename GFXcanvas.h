@@ -0,0 +1,57 @@
+#ifndef _GFXCANVAS_H
+#define _GFXCANVAS_H
+
+#include "Adafruit_mfGFX.h"
+
+// Offscreen drawing surfaces.  Anything Adafruit_GFX can draw may be
+// rendered into a canvas once and then composited onto an RGBmatrixPanel
+// (see RGBmatrixPanel::drawCanvas()) as often as needed, so static parts
+// of a scene don't have to be re-rasterized every frame.
+
+// 1-bit canvas.  Buffer layout matches drawBitmap(): rows of (w+7)/8
+// bytes, MSB first.  Set bits are drawn in the color given at composite
+// time, clear bits are transparent.
+class GFXcanvas1 : public Adafruit_GFX {
+
+ public:
+
+  GFXcanvas1(uint16_t w, uint16_t h);
+  ~GFXcanvas1(void);
+
+  void
+    drawPixel(int16_t x, int16_t y, uint16_t color),
+    fillScreen(uint16_t color);
+  uint8_t
+    *getBuffer(void);
+
+ private:
+
+  uint8_t *buffer;
+};
+
+// 4/4/4 canvas, one 0x0RGB word per pixel (the matrix's native depth, so
+// compositing needs no color conversion).  Pixels equal to the
+// transparency key (black by default) are skipped when composited.
+class GFXcanvas444 : public Adafruit_GFX {
+
+ public:
+
+  GFXcanvas444(uint16_t w, uint16_t h);
+  ~GFXcanvas444(void);
+
+  void
+    drawPixel(int16_t x, int16_t y, uint16_t color),
+    fillScreen(uint16_t color),
+    setTransparent(uint16_t color),
+    setOpaque(void);
+  uint16_t
+    getTransparent(void),
+    *getBuffer(void);
+
+ private:
+
+  uint16_t *buffer;
+  uint16_t  key;
+};
+
+#endif // _GFXCANVAS_H
@@ -0,0 +1,109 @@
+/*
+ Plasma effect kernel, see Plasma.h.
+*/
+
+#include "Plasma.h"
+
+static const int8_t PROGMEM sinetab[256] = {
+     0,   2,   5,   8,  11,  15,  18,  21,
+    24,  27,  30,  33,  36,  39,  42,  45,
+    48,  51,  54,  56,  59,  62,  65,  67,
+    70,  72,  75,  77,  80,  82,  85,  87,
+    89,  91,  93,  96,  98, 100, 101, 103,
+   105, 107, 108, 110, 111, 113, 114, 116,
+   117, 118, 119, 120, 121, 122, 123, 123,
+   124, 125, 125, 126, 126, 126, 126, 126,
+   127, 126, 126, 126, 126, 126, 125, 125,
+   124, 123, 123, 122, 121, 120, 119, 118,
+   117, 116, 114, 113, 111, 110, 108, 107,
+   105, 103, 101, 100,  98,  96,  93,  91,
+    89,  87,  85,  82,  80,  77,  75,  72,
+    70,  67,  65,  62,  59,  56,  54,  51,
+    48,  45,  42,  39,  36,  33,  30,  27,
+    24,  21,  18,  15,  11,   8,   5,   2,
+     0,  -3,  -6,  -9, -12, -16, -19, -22,
+   -25, -28, -31, -34, -37, -40, -43, -46,
+   -49, -52, -55, -57, -60, -63, -66, -68,
+   -71, -73, -76, -78, -81, -83, -86, -88,
+   -90, -92, -94, -97, -99,-101,-102,-104,
+  -106,-108,-109,-111,-112,-114,-115,-117,
+  -118,-119,-120,-121,-122,-123,-124,-124,
+  -125,-126,-126,-127,-127,-127,-127,-127,
+  -128,-127,-127,-127,-127,-127,-126,-126,
+  -125,-124,-124,-123,-122,-121,-120,-119,
+  -118,-117,-115,-114,-112,-111,-109,-108,
+  -106,-104,-102,-101, -99, -97, -94, -92,
+   -90, -88, -86, -83, -81, -78, -76, -73,
+   -71, -68, -66, -63, -60, -57, -55, -52,
+   -49, -46, -43, -40, -37, -34, -31, -28,
+   -25, -22, -19, -16, -12,  -9,  -6,  -3
+};
+
+// Orbit of each wave's centre, and how far along it moves per PLASMA_FRAME_MS
+static const q16_16 radius[4]  = { FIX16(65.2), FIX16(92.0), FIX16(163.2), FIX16(176.8) },
+                    centerx[4] = { FIX16(64.4), FIX16(46.4), FIX16( 93.6), FIX16( 16.4) },
+                    centery[4] = { FIX16(34.8), FIX16(26.0), FIX16( 56.0), FIX16(-11.6) };
+static const int16_t speed[4]  = { FIXANGLE(0.03), FIXANGLE(-0.07), FIXANGLE(0.13), FIXANGLE(-0.15) };
+
+// Distance squared to sinetab index: the two inner waves are tighter
+static const uint8_t shift[4] = { 4, 4, 5, 5 };
+
+#define WAVE(d, k)	((int8_t)pgm_read_byte(sinetab + (uint8_t)((d) >> shift[k])))
+
+Plasma::Plasma(void) {
+  for(uint8_t k=0; k<4; k++) {
+    angle[k] = 0;
+    cx[k]    = cy[k] = 0;
+  }
+}
+
+// Centres for the frame about to be rendered, from the current angles,
+// which then move on by 'ms' worth of each wave's speed for the next one
+
+void Plasma::nextFrame(uint16_t ms) {
+  for(uint8_t k=0; k<4; k++) {
+    cx[k] = FIX16_TO_INT(fix16_mul_q15(radius[k], fix_cos(angle[k])) + centerx[k]);
+    cy[k] = FIX16_TO_INT(fix16_mul_q15(radius[k], fix_sin(angle[k])) + centery[k]);
+    angle[k] += (int32_t)speed[k] * ms / PLASMA_FRAME_MS;
+  }
+}
+
+// row[x] for x = 0 .. width-1 of row y.  The wave centred at (cx, cy)
+// is sampled at (cx - x, cy - y), as the original plasma did.  With
+// step > 1 only x = 0, step, 2*step ... are computed, each filling the
+// step entries from it.
+void Plasma::renderRow(int16_t y, uint8_t row[], uint8_t width, uint8_t step) {
+  int32_t d0, d1, d2, d3, s0, s1, s2, s3, v, ds = 2 * step * step;
+  uint8_t n;
+
+  // Squared distances at x = 0, and their first steps:
+  // (c - x - step)^2 = (c - x)^2 - step * (2 * (c - x) - step)
+  v  = cy[0] - y;  d0 = cx[0] * cx[0] + v * v;  s0 = step * (2 * cx[0] - step);
+  v  = cy[1] - y;  d1 = cx[1] * cx[1] + v * v;  s1 = step * (2 * cx[1] - step);
+  v  = cy[2] - y;  d2 = cx[2] * cx[2] + v * v;  s2 = step * (2 * cx[2] - step);
+  v  = cy[3] - y;  d3 = cx[3] * cx[3] + v * v;  s3 = step * (2 * cx[3] - step);
+
+  if(step == 1) {                        // Full resolution, the common case
+    while(width--) {
+      v = WAVE(d0, 0) + WAVE(d1, 1) + WAVE(d2, 2) + WAVE(d3, 3);
+      *row++ = (uint8_t)(v >> 1);        // 512 hue steps -> 256
+      d0 -= s0;  s0 -= 2;
+      d1 -= s1;  s1 -= 2;
+      d2 -= s2;  s2 -= 2;
+      d3 -= s3;  s3 -= 2;
+    }
+    return;
+  }
+
+  while(width) {
+    v = WAVE(d0, 0) + WAVE(d1, 1) + WAVE(d2, 2) + WAVE(d3, 3);
+    n = (step < width) ? step : width;
+    width -= n;
+    memset(row, (uint8_t)(v >> 1), n);
+    row += n;
+    d0 -= s0;  s0 -= ds;
+    d1 -= s1;  s1 -= ds;
+    d2 -= s2;  s2 -= ds;
+    d3 -= s3;  s3 -= ds;
+  }
+}
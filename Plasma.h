@@ -0,0 +1,38 @@
+#ifndef _PLASMA_H
+#define _PLASMA_H
+
+#include "application.h"
+#include "fixmath.h"
+
+// The plasma effect: four circular waves whose centres orbit slowly,
+// summed at each pixel.  Each wave is sinetab[] of the pixel's squared
+// distance from its centre, so the field is an 8-bit "hue index" per
+// pixel: 0 - 255 meaning hue steps 0 - 510, to be turned into colors by
+// a palette (see RGBmatrixPanel::setHuePalette()).
+//
+// Along a row the squared distances are updated by adding the difference
+// of consecutive squares, (x-1)^2 = x^2 - (2x - 1), itself stepped by 2,
+// so the inner loop is additions and four table lookups per pixel.
+// The same works for every step-th pixel, with steps of the squares of
+// multiples of 'step', which is how a row is rendered at lower
+// resolution (see FramePacer::scale()).
+
+#define PLASMA_FRAME_MS	150	// The waves' speeds are per this many ms
+
+class Plasma {
+
+ public:
+
+  Plasma(void);
+
+  void
+    nextFrame(uint16_t ms=PLASMA_FRAME_MS),  // Before each frame; ms since the last
+    renderRow(int16_t y, uint8_t row[], uint8_t width, uint8_t step=1);  // Hue indices
+
+ private:
+
+  uint16_t angle[4];           // 65536 = 2*PI
+  int32_t  cx[4], cy[4];       // This frame's centres, whole pixels
+};
+
+#endif // _PLASMA_H
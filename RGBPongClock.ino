@@ -23,9 +23,14 @@
 #include "Adafruit_mfGFX.h"   // Core graphics library
 #include "RGBmatrixPanel.h" // Hardware-specific library
 #include "fix_fft.h"
+#include "spectrum.h"
+#include "window.h"
+#include "AudioSampler.h"
+#include "AudioAnalyzer.h"
+#include "fixmath.h"
+#include "Plasma.h"
+#include "FramePacer.h"
 #include "blinky.h"
-#include "font3x5.h"
-#include "font5x5.h"
 
 //#define DEBUGME
 
@@ -131,7 +136,7 @@ struct SpecialDays {
   char* message;
 };
 
-const SpecialDays ourHolidays[] = {  //keep message to < 40 chars
+const SpecialDays ourHolidays[] = {  //keep message to STRIP_CHARS (40) chars, longer is cut
   { 1, 1, "HAPPY NEW YEAR"},
   { 2, 14, "HAPPY ST PATRICKS DAY"},
   { 4, 1, "HAPPY BIRTHDAY TOM"},
@@ -162,6 +167,48 @@ RGBmatrixPanel matrix(A, B, C, CLK, LAT, OE, true, 32);	// 16x32
 //RGBmatrixPanel matrix(A, B, C, D,CLK, LAT, OE, true, 64); // 64x32
 /*******************************************/
 
+/********** Scrolling message strip **********
+ scrollMessage() renders both text lines into this 1-bit strip once and
+ then only copies the visible 32 column window to the matrix at each
+ scroll step.  Each column is a single word holding all 16 rows.  Lines
+ longer than STRIP_CHARS are cut to that length. */
+#define STRIP_CHARS		40		// Longest line, in 5x5 font characters
+#define STRIP_WIDTH		(STRIP_CHARS * 6 + 32)	// Plus slack
+
+class TextStrip : public Adafruit_GFX {
+
+ public:
+
+  TextStrip(void) : Adafruit_GFX(STRIP_WIDTH, 16) { }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t c) {
+    if((x < 0) || (x >= STRIP_WIDTH) || (y < 0) || (y >= 16)) return;
+    if(c) cols[x] |=  (1 << y);
+    else  cols[x] &= ~(1 << y);
+  }
+
+  void fillScreen(uint16_t c) {
+    memset(cols, c ? 0xFF : 0x00, sizeof(cols));
+  }
+
+  uint16_t cols[STRIP_WIDTH];
+};
+
+TextStrip msgStrip;
+/*********************************************/
+
+/********** Clock overlay layer **********
+ pong(), spectrumDisplay() and plasma() show a small hh mm readout over an
+ animated background.  The digits live in this overlay, which the matrix
+ merges over each frame on swapBuffers(); it is only redrawn when the
+ time (or look) changes. */
+#define OVERLAY_X	7
+#define OVERLAY_Y	0
+
+GFXcanvas444 clockOverlay(19, 7);
+/*****************************************/
+
+
 int stringPos;
 boolean weatherGood=false;
 int badWeatherCall;
@@ -175,6 +222,7 @@ boolean wasWeatherShownLast= true;
 unsigned long lastWeatherTime =0;
 
 int mode_changed = 0;			// Flag if mode changed.
+bool fadeIn = false;			// Cross-fade into the next mode's first frame, see showFrame()
 bool mode_quick = false;		// Quick weather display
 int clock_mode = 0;				// Default clock mode (1 = pong)
 uint16_t showClock = 300;		// Default time to show a clock face
@@ -190,67 +238,36 @@ unsigned long updateCTime;		// 24hr timer for resyncing cloud time
 
 // Define MIC input pin
 #define MIC A5			// A7 for Core, A5 for Photon
+#define MIC_RATE 8000	// Samples per second; FFT bin k is k * MIC_RATE / 128 Hz
+
+#define SPECTRUM_HOP 64	// New samples per spectrum frame: 32, 64 or 128 (no overlap)
 
-int8_t im[128];
-int8_t fftdata[128];
-int8_t spectrum[32];
+AudioSampler mic(MIC, SPECTRUM_HOP);	// Timer-driven sampling, one block per frame
+AudioAnalyzer audio(mic);	// Onsets, tempo and band levels for the other modes
 
-byte
-peak[32],		// Peak level of each column; used for falling dots
-dotCount = 0,	// Frame counter for delaying dot-falling speed
-colCount = 0;	// Frame counter for storing past column data
+int16_t fftdata[SPECTRUM_POINTS];
+uint8_t fftWindow = WINDOW_HANN;	// Applied as samples are read; set with setMode("window=...")
+int16_t spectrum[SPECTRUM_COLUMNS];
+uint16_t spectrumEdges[SPECTRUM_COLUMNS + 1];	// FFT bins of each column, see spectrum.h
 
-int8_t
-col[32][10],	// Column levels for the prior 10 frames
-minLvlAvg[32],	// For dynamic adjustment of low & high ends of graph,
-maxLvlAvg[32];	// pseudo rolling averages for the prior few frames.
+uint8_t spectrumBands = SPECTRUM_COLUMNS;	// Bands shown, set with setMode("bands=N")
+SpectrumHistory spectrumHistory;	// Last 128 samples, for overlapped frames
+SpectrumGoertzel spectrumGoertzel;	// Used instead of the FFT for a few bands
+SpectrumLevels spectrumLevels;	// Auto-gained column heights and falling peak dots
 #endif
 /***************************************/
 
 /************  PLASMA definitions **********/
 
-static const int8_t PROGMEM sinetab[256] = {
-     0,   2,   5,   8,  11,  15,  18,  21,
-    24,  27,  30,  33,  36,  39,  42,  45,
-    48,  51,  54,  56,  59,  62,  65,  67,
-    70,  72,  75,  77,  80,  82,  85,  87,
-    89,  91,  93,  96,  98, 100, 101, 103,
-   105, 107, 108, 110, 111, 113, 114, 116,
-   117, 118, 119, 120, 121, 122, 123, 123,
-   124, 125, 125, 126, 126, 126, 126, 126,
-   127, 126, 126, 126, 126, 126, 125, 125,
-   124, 123, 123, 122, 121, 120, 119, 118,
-   117, 116, 114, 113, 111, 110, 108, 107,
-   105, 103, 101, 100,  98,  96,  93,  91,
-    89,  87,  85,  82,  80,  77,  75,  72,
-    70,  67,  65,  62,  59,  56,  54,  51,
-    48,  45,  42,  39,  36,  33,  30,  27,
-    24,  21,  18,  15,  11,   8,   5,   2,
-     0,  -3,  -6,  -9, -12, -16, -19, -22,
-   -25, -28, -31, -34, -37, -40, -43, -46,
-   -49, -52, -55, -57, -60, -63, -66, -68,
-   -71, -73, -76, -78, -81, -83, -86, -88,
-   -90, -92, -94, -97, -99,-101,-102,-104,
-  -106,-108,-109,-111,-112,-114,-115,-117,
-  -118,-119,-120,-121,-122,-123,-124,-124,
-  -125,-126,-126,-127,-127,-127,-127,-127,
-  -128,-127,-127,-127,-127,-127,-126,-126,
-  -125,-124,-124,-123,-122,-121,-120,-119,
-  -118,-117,-115,-114,-112,-111,-109,-108,
-  -106,-104,-102,-101, -99, -97, -94, -92,
-   -90, -88, -86, -83, -81, -78, -76, -73,
-   -71, -68, -66, -63, -60, -57, -55, -52,
-   -49, -46, -43, -40, -37, -34, -31, -28,
-   -25, -22, -19, -16, -12,  -9,  -6,  -3
-};
-
-const float radius1  = 65.2, radius2  = 92.0, radius3  = 163.2, radius4  = 176.8,
-            centerx1 = 64.4, centerx2 = 46.4, centerx3 =  93.6, centerx4 =  16.4, 
-            centery1 = 34.8, centery2 = 26.0, centery3 =  56.0, centery4 = -11.6;
-float       angle1   =  0.0, angle2   =  0.0, angle3   =   0.0, angle4   =   0.0;
-long        hueShift =  0;
+Plasma       plasmaField;	// Wave centres and the per-row kernel, see Plasma.h
+long         hueShift =  0;
 /*******************************************/
 
+/********** Frame pacing ***********/
+FramePacer   framePacer(30);	// Frames per second, set with setMode("fps=N")
+int          frameRate = 0;	// Achieved fps of the animated mode, cloud variable "fps"
+/***********************************/
+
 /*************** Night Mode ****************/
 struct TimerObject{
   int hour, minute;
@@ -277,16 +294,20 @@ void drawPac(int x, int y, int z);
 void drawGhost( int x, int y, int color);
 void drawScaredGhost( int x, int y);
 void cls();
+void crossFade();
+void showFrame(boolean copy);
+void fadeOut();
 void pong();
-byte pong_get_ball_endpoint(float tempballpos_x, float  tempballpos_y, float  tempballvel_x, float tempballvel_y);
+byte pong_get_ball_endpoint(q8_8 tempballpos_x, q8_8  tempballpos_y, q8_8  tempballvel_x, q8_8 tempballvel_y);
 void normal_clock();
-void vectorNumber(int n, int x, int y, int color, float scale_x, float scale_y);
+void vectorNumber(int n, int x, int y, int color, float scale_x, float scale_y, Adafruit_GFX &gfx = matrix);
+void updateClockOverlay(uint16_t color, boolean colon, boolean box);
 void word_clock();
 void jumble();
 void display_date();
 void flashing_cursor(byte xpos, byte ypos, byte cursor_width, byte cursor_height, byte repeats);
-void drawString(int x, int y, char* c,uint8_t font_size, uint16_t color);
-void drawChar(int x, int y, char c, uint8_t font_size, uint16_t color);
+void drawString(int x, int y, char* c,uint8_t font_size, uint16_t color, Adafruit_GFX &gfx = matrix);
+void drawChar(int x, int y, char c, uint8_t font_size, uint16_t color, Adafruit_GFX &gfx = matrix);
 int calc_font_displacement(uint8_t font_size);
 void spectrumDisplay();
 void plasma();
@@ -294,6 +315,9 @@ void marquee();
 void nitelite();
 int timerEvaluate(const struct TimerObject on_time, const struct TimerObject off_time, const unsigned int currentTime);
 time_t tmConvert_t(int YYYY, byte MM, byte DD, byte hh, byte mm, byte ss);
+#ifdef USING_SPECIAL_MESSAGES
+char* getMessageOfTheDay();
+#endif
 #ifdef DST_CENTRAL_EUROPE
   bool IsDst(int day, int month, int dayOfWeek);
 #endif
@@ -326,6 +350,7 @@ void setup() {
 
 	Spark.variable("city", city, STRING);	// !!! FOR DEBUGGING ONLY !!!
 	Spark.variable("cmode", &clock_mode, INT);
+	Spark.variable("fps", &frameRate, INT);
 	
 	Spark.function("setMode", setMode);		// Receive mode commands
 	Spark.subscribe(HOOK_RESP, processWeather, MY_DEVICES);	// Lets listen for the hook response
@@ -350,15 +375,6 @@ void setup() {
 	matrix.setTextSize(1);
 	matrix.setTextColor(matrix.Color333(210, 210, 210));
 
-#if defined useFFT
-	memset(peak, 0, sizeof(peak));
-	memset(col , 0, sizeof(col));
-
-	for(uint8_t i=0; i<32; i++) {
-		minLvlAvg[i] = 0;
-		maxLvlAvg[i] = 255;
-	}
-#endif
 
 	randomSeed(analogRead(A7));
 	
@@ -394,7 +410,7 @@ void loop()
 
     if (millis() - modeSwitch > 120000UL) {	//Switch modes every 5 mins
       clock_mode++;
-      mode_changed = 1;
+      fadeIn = true;
       modeSwitch = millis();
       if (clock_mode > MAX_CLOCK_MODE - 1)
         clock_mode = 0;
@@ -431,24 +447,30 @@ void loop()
         normal_clock();
         break;
     }
+    matrix.setOverlay(NULL);
+    matrix.setIndexed(false);
+#if defined useFFT
+    mic.end();
+#endif
 
     //if the mode hasn't changed, show the date
-    pacClear();
     if (mode_changed == 0) {
+      pacClear();
       display_date();
       pacClear();
     }
     else {
       //the mode has changed, so don't bother showing the date, just go to the new mode.
+      //Its last frame stays on screen and cross-fades into the new mode's first one.
       mode_changed = 0; //reset mdoe flag.
+      fadeIn = true;
     }
   }
   else
   {
     if(mode_changed == 1)
     {
-      matrix.fillScreen(0);
-      matrix.swapBuffers(false);
+      fadeOut();
       mode_changed = 0;
     }
     nitelite();
@@ -550,6 +572,35 @@ int setMode(String command)
 			weatherGood = false;
 			return 1;
 		}		
+		else if(command.substring(0,j) == "fps")
+		{
+			int fps = command.substring(j+1).toInt();
+			if(fps < 1 || fps > 100) return -1;
+			framePacer.setTarget(fps);
+			return 1;
+		}
+#if defined useFFT
+		else if(command.substring(0,j) == "bands")
+		{
+			int bands = command.substring(j+1).toInt();
+			if(bands < 1 || bands > SPECTRUM_COLUMNS) return -1;
+			spectrumBands = bands;
+			mode_changed = 1;		// Restart the spectrum with them
+			clock_mode = 4;
+			modeSwitch = millis();
+			return 1;
+		}
+		else if(command.substring(0,j) == "window")
+		{
+			String shape = command.substring(j+1);
+			if(shape == "none")          fftWindow = WINDOW_RECTANGULAR;
+			else if(shape == "hann")     fftWindow = WINDOW_HANN;
+			else if(shape == "hamming")  fftWindow = WINDOW_HAMMING;
+			else if(shape == "blackman") fftWindow = WINDOW_BLACKMAN;
+			else return -1;
+			return 1;
+		}
+#endif
 	}
 	else if(command == "normal")
 	{
@@ -738,7 +789,7 @@ void showWeather(){
 			}
 		}
 
-		matrix.swapBuffers(true);
+		crossFade();
 		drawWeatherIcon(16,0,atoi(w_id[i]));
 
 		Spark.process();	//Give the background process some lovin'
@@ -882,18 +933,42 @@ void scrollBigMessage(char *m){
 
 void scrollMessage(char* top, char* bottom ,uint8_t top_font_size,uint8_t bottom_font_size, uint16_t top_color, uint16_t bottom_color){
 
+	char topLine[STRIP_CHARS + 1], bottomLine[STRIP_CHARS + 1];
+
+	// The strip only holds STRIP_CHARS characters; cut longer lines at a
+	// character rather than part way through one
+	if (strlen(top) > STRIP_CHARS || strlen(bottom) > STRIP_CHARS)
+		DEBUGpln("scrollMessage: line longer than STRIP_CHARS, cut");
+	strncpy(topLine, top, STRIP_CHARS);
+	topLine[STRIP_CHARS] = 0;
+	strncpy(bottomLine, bottom, STRIP_CHARS);
+	bottomLine[STRIP_CHARS] = 0;
+	top = topLine;
+	bottom = bottomLine;
+
 	int l = ((strlen(top)>strlen(bottom)?strlen(top):strlen(bottom))*-5) - 32;
-	
+
+	// Rasterize both lines once; rows 0-7 take the top color, 8-15 the bottom
+	msgStrip.fillScreen(0);
+	drawString(0,1,top,top_font_size, 1, msgStrip);
+	drawString(0,9,bottom, bottom_font_size, 1, msgStrip);
+
 	for(int i=32; i > l; i--){
 		
 		if (mode_changed == 1 || mode_quick)
 			return;
 
 		cls();
-		
-		drawString(i,1,top,top_font_size, top_color);
-		drawString(i,9,bottom, bottom_font_size, bottom_color);
-		matrix.swapBuffers(false);
+
+		// Copy the visible window: screen column x shows strip column x - i
+		for(int x = (i > 0 ? i : 0); x < 32 && (x - i) < STRIP_WIDTH; x++){
+			uint16_t bits = msgStrip.cols[x - i];
+			for(uint8_t y = 0; bits; y++, bits >>= 1){
+				if(bits & 1)
+					matrix.drawPixel(x, y, (y < 8) ? top_color : bottom_color);
+			}
+		}
+		showFrame(false);
 		delay(50);
 		Spark.process();
 	}
@@ -1034,13 +1109,67 @@ void cls(){
 	matrix.fillScreen(0);
 }
 
+// Show the frame drawn in the back buffer by cross-fading to it from the
+// one on screen, instead of cutting.  The blends work on the packed
+// buffers, so each step costs far less than redrawing.  The new frame is
+// finished first (index buffer resolved, overlay merged) and kept in a
+// copy while the steps are drawn into the back buffer; each step closes
+// part of the remaining gap and the last one lands on it exactly.
+// Afterwards both buffers hold the new frame, as after swapBuffers(true).
+void crossFade()
+{
+	static uint8_t *target = NULL;
+	int size = matrix.width() * matrix.height() * 3 / 2;	// Packed buffer bytes
+
+	matrix.composeFrame();
+	if (!target) target = (uint8_t *)malloc(size);
+	if (!target) {
+		matrix.swapBuffers(true, false);	// No RAM, just cut
+		return;
+	}
+	memcpy(target, matrix.backBuffer(), size);
+	for (byte step = 0; step < 8; step++) {
+		matrix.blendBuffers(matrix.frontBuffer(), target, step < 7 ? 80 : 255);
+		matrix.swapBuffers(false, false);
+		delay(20);
+	}
+	memcpy(matrix.backBuffer(), target, size);
+}
+
+// The clock modes show each frame with this instead of swapBuffers(), so
+// that the first frame after a mode switch cross-fades in from the last
+// one of the mode before (see loop()).
+void showFrame(boolean copy)
+{
+	if (fadeIn) {
+		fadeIn = false;
+		crossFade();
+	}
+	else
+		matrix.swapBuffers(copy);
+}
+
+// Fade whatever is on screen to black by repeatedly scaling the displayed
+// frame into the back buffer.
+void fadeOut()
+{
+	for (byte step = 0; step < 15; step++) {
+		matrix.fadeBuffer(matrix.frontBuffer(), 176);
+		matrix.swapBuffers(false);
+		delay(20);
+	}
+	cls();
+	matrix.swapBuffers(false);
+}
+
+FIXMATH_HOT_BEGIN
 void pong(){
 	DEBUGpln("in Pong");
 	matrix.setTextSize(1);
 	matrix.setTextColor(matrix.Color333(2, 2, 2));
 
-	float ballpos_x, ballpos_y;
-	float ballvel_x, ballvel_y;
+	q8_8 ballpos_x, ballpos_y;	// 8.8 fixed point, see fixmath.h
+	q8_8 ballvel_x, ballvel_y;
 	int bat1_y = 5;  //bat starting y positions
 	int bat2_y = 5;  
 	int bat1_target_y = 5;  //bat targets for bats to move to
@@ -1050,6 +1179,11 @@ void pong(){
 	byte bat1miss, bat2miss; //flags set on the minute or hour that trigger the bats to miss the ball, thus upping the score to match the time.
 	byte restart = 1;   //game restart flag - set to 1 initially to setup 1st game
 
+	// Colors drawn every frame, converted to the matrix's native 4/4/4 once
+	const rgb444_t pitchColor = matrix.RGB444(matrix.Color333(0,4,0));
+	const rgb444_t batColor   = matrix.RGB444(matrix.Color333(0,0,4));
+	const rgb444_t ballColor  = matrix.RGB444(matrix.Color333(4,0,0));
+
 	cls();
 
 //	for(int i=0; i< SHOWCLOCK; i++) {
@@ -1062,7 +1196,7 @@ void pong(){
 		if(Time.second()%2==0)adjust=1;
 		for (byte i = 0; i <16; i++) {
 			if ( i % 2 == 0 ) { //plot point if an even number
-				matrix.drawPixel(16,i+adjust,matrix.Color333(0,4,0));
+				matrix.drawPixel(16,i+adjust,pitchColor);
 			}
 		} 
 
@@ -1071,60 +1205,35 @@ void pong(){
 		return;
 		if(mode_quick){
 			mode_quick = false;
+			matrix.setOverlay(NULL);
 			display_date();
 			quickWeather();
 			pong();
 			return;
 		}	
 
-		int ampm=0;
 		//update score / time
-		byte mins = Time.minute();
-		byte hours = Time.hour();
-		if (hours > 12) {
-			hours = hours - ampm * 12;
-		}
-		if (hours < 1) {
-			hours = hours + ampm * 12;
-		}
-
-		char buffer[3];
-
-		itoa(hours,buffer,10);
-		//fix - as otherwise if num has leading zero, e.g. "03" hours, itoa coverts this to chars with space "3 ". 
-		if (hours < 10) {
-			buffer[1] = buffer[0];
-			buffer[0] = '0';
-		}
-		vectorNumber(buffer[0]-'0',8,1,matrix.Color333(1,1,1),1,1);
-		vectorNumber(buffer[1]-'0',12,1,matrix.Color333(1,1,1),1,1);
-
-		itoa(mins,buffer,10); 
-		if (mins < 10) {
-			buffer[1] = buffer[0];
-			buffer[0] = '0';
-		} 
-		vectorNumber(buffer[0]-'0',18,1,matrix.Color333(1,1,1),1,1);
-		vectorNumber(buffer[1]-'0',22,1,matrix.Color333(1,1,1),1,1);
+		updateClockOverlay(matrix.Color333(1,1,1), false, false);
+		matrix.setOverlay(&clockOverlay, OVERLAY_X, OVERLAY_Y);
 
 		//if restart flag is 1, setup a new game
 		if (restart) {
 			//set ball start pos
-			ballpos_x = 16;
-			ballpos_y = random (4,12);
+			ballpos_x = INT_TO_FIX8(16);
+			ballpos_y = INT_TO_FIX8(random (4,12));
 
 			//pick random ball direction
 			if (random(0,2) > 0) {
-				ballvel_x = 1; 
+				ballvel_x = INT_TO_FIX8(1); 
 			} 
 			else {
-				ballvel_x = -1;
+				ballvel_x = INT_TO_FIX8(-1);
 			}
 			if (random(0,2) > 0) {
-				ballvel_y = 0.5; 
+				ballvel_y = FIX8(0.5); 
 			} 
 			else {
-				ballvel_y = -0.5;
+				ballvel_y = FIX8(-0.5);
 			}
 			//draw bats in initial positions
 			bat1miss = 0; 
@@ -1146,16 +1255,16 @@ void pong(){
 		//very basic AI...
 		// For each bat, First just tell the bat to move to the height of the ball when we get to a random location.
 		//for bat1
-		if (ballpos_x == random(18,32)){
-			bat1_target_y = ballpos_y;
+		if (ballpos_x == INT_TO_FIX8(random(18,32))){
+			bat1_target_y = FIX8_TO_INT(ballpos_y);
 		}
 		//for bat2
-		if (ballpos_x == random(4,16)){
-			bat2_target_y = ballpos_y;
+		if (ballpos_x == INT_TO_FIX8(random(4,16))){
+			bat2_target_y = FIX8_TO_INT(ballpos_y);
 		}
 
 		//when the ball is closer to the left bat, run the ball maths to find out where the ball will land
-		if (ballpos_x == 15 && ballvel_x < 0) {
+		if (ballpos_x == INT_TO_FIX8(15) && ballvel_x < 0) {
 
 			byte end_ball_y = pong_get_ball_endpoint(ballpos_x, ballpos_y, ballvel_x, ballvel_y);
 
@@ -1185,7 +1294,7 @@ void pong(){
 		//right bat AI
 		//if positive velocity then predict for right bat - first just match ball height
 		//when the ball is closer to the right bat, run the ball maths to find out where it will land
-		if (ballpos_x == 17 && ballvel_x > 0) {
+		if (ballpos_x == INT_TO_FIX8(17) && ballvel_x > 0) {
 
 			byte end_ball_y = pong_get_ball_endpoint(ballpos_x, ballpos_y, ballvel_x, ballvel_y);
 
@@ -1228,7 +1337,7 @@ void pong(){
 
 		//draw bat 1
 		if (bat1_update){
-			matrix.fillRect(BAT1_X-1,bat1_y,2,6,matrix.Color333(0,0,4));
+			matrix.fillRect(BAT1_X-1,bat1_y,2,6,batColor);
 		}
 
 		//move bat 2 towards target (dont go any further or bat will move off screen)
@@ -1246,7 +1355,7 @@ void pong(){
 
 		//draw bat2
 		if (bat2_update){
-			matrix.fillRect(BAT2_X+1,bat2_y,2,6,matrix.Color333(0,0,4));
+			matrix.fillRect(BAT2_X+1,bat2_y,2,6,batColor);
 		}
 
 		//update the ball position using the velocity
@@ -1259,14 +1368,14 @@ void pong(){
 			ballpos_y = 0; //make sure value goes no less that 0
 		}
 
-		if (ballpos_y >= 15){
+		if (ballpos_y >= INT_TO_FIX8(15)){
 			ballvel_y = ballvel_y * -1;
-			ballpos_y = 15; //make sure value goes no more than 15
+			ballpos_y = INT_TO_FIX8(15); //make sure value goes no more than 15
 		}
 
 		//check for ball collision with bat1. check ballx is same as batx
 		//and also check if bally lies within width of bat i.e. baty to baty + 6. We can use the exp if(a < b && b < c) 
-		if ((int)ballpos_x == BAT1_X+1 && (bat1_y <= (int)ballpos_y && (int)ballpos_y <= bat1_y + 5) ) { 
+		if (FIX8_TO_INT(ballpos_x) == BAT1_X+1 && (bat1_y <= FIX8_TO_INT(ballpos_y) && FIX8_TO_INT(ballpos_y) <= bat1_y + 5) ) { 
 
 			//random if bat flicks ball to return it - and therefor changes ball velocity
 			if(!random(0,3)) { //not true = no flick - just straight rebound and no change to ball y vel
@@ -1294,8 +1403,8 @@ void pong(){
 				case 0:
 					bat1_target_y = bat1_target_y + random(1,3);
 					ballvel_x = ballvel_x * -1;
-					if (ballvel_y < 2) {
-						ballvel_y = ballvel_y + 0.2;
+					if (ballvel_y < INT_TO_FIX8(2)) {
+						ballvel_y = ballvel_y + FIX8(0.2);
 					}
 					break;
 
@@ -1303,8 +1412,8 @@ void pong(){
 				case 1:   
 					bat1_target_y = bat1_target_y - random(1,3);
 					ballvel_x = ballvel_x * -1;
-					if (ballvel_y > 0.2) {
-						ballvel_y = ballvel_y - 0.2;
+					if (ballvel_y > FIX8(0.2)) {
+						ballvel_y = ballvel_y - FIX8(0.2);
 					}
 					break;
 				}
@@ -1313,7 +1422,7 @@ void pong(){
 
 		//check for ball collision with bat2. check ballx is same as batx
 		//and also check if bally lies within width of bat i.e. baty to baty + 6. We can use the exp if(a < b && b < c) 
-		if ((int)ballpos_x == BAT2_X && (bat2_y <= (int)ballpos_y && (int)ballpos_y <= bat2_y + 5) ) { 
+		if (FIX8_TO_INT(ballpos_x) == BAT2_X && (bat2_y <= FIX8_TO_INT(ballpos_y) && FIX8_TO_INT(ballpos_y) <= bat2_y + 5) ) { 
 
 			//random if bat flicks ball to return it - and therefor changes ball velocity
 			if(!random(0,3)) {
@@ -1340,8 +1449,8 @@ void pong(){
 				case 0:
 					bat2_target_y = bat2_target_y + random(1,3);
 					ballvel_x = ballvel_x * -1;
-					if (ballvel_y < 2) {
-						ballvel_y = ballvel_y + 0.2;
+					if (ballvel_y < INT_TO_FIX8(2)) {
+						ballvel_y = ballvel_y + FIX8(0.2);
 					}
 					break;
 
@@ -1349,8 +1458,8 @@ void pong(){
 				case 1:   
 					bat2_target_y = bat2_target_y - random(1,3);
 					ballvel_x = ballvel_x * -1;
-					if (ballvel_y > 0.2) {
-						ballvel_y = ballvel_y - 0.2;
+					if (ballvel_y > FIX8(0.2)) {
+						ballvel_y = ballvel_y - FIX8(0.2);
 					}
 					break;
 				}
@@ -1358,34 +1467,38 @@ void pong(){
 		}
 
 		//plot the ball on the screen
-		byte plot_x = (int)(ballpos_x + 0.5f);
-		byte plot_y = (int)(ballpos_y + 0.5f);
+		byte plot_x = FIX8_ROUND(ballpos_x);
+		byte plot_y = FIX8_ROUND(ballpos_y);
 
-		matrix.drawPixel(plot_x,plot_y,matrix.Color333(4, 0, 0));
+		matrix.drawPixel(plot_x,plot_y,ballColor);
 
 		//check if a bat missed the ball. if it did, reset the game.
-		if ((int)ballpos_x == 0 ||(int) ballpos_x == 32){
+		if (FIX8_TO_INT(ballpos_x) == 0 || FIX8_TO_INT(ballpos_x) == 32){
 			restart = 1; 
 		}
 
 		Spark.process();	//Give the background process some lovin'
 		delay(40);
-		matrix.swapBuffers(false);
+		showFrame(false);
 	} 
 }
-byte pong_get_ball_endpoint(float tempballpos_x, float  tempballpos_y, float  tempballvel_x, float tempballvel_y) {
+FIXMATH_HOT_END
+
+FIXMATH_HOT_BEGIN
+byte pong_get_ball_endpoint(q8_8 tempballpos_x, q8_8  tempballpos_y, q8_8  tempballvel_x, q8_8 tempballvel_y) {
 
 	//run prediction until ball hits bat
-	while (tempballpos_x > BAT1_X && tempballpos_x < BAT2_X  ){
+	while (tempballpos_x > INT_TO_FIX8(BAT1_X) && tempballpos_x < INT_TO_FIX8(BAT2_X)  ){
 		tempballpos_x = tempballpos_x + tempballvel_x;
 		tempballpos_y = tempballpos_y + tempballvel_y;
 		//check for collisions with top / bottom
-		if (tempballpos_y <= 0 || tempballpos_y >= 15){
+		if (tempballpos_y <= 0 || tempballpos_y >= INT_TO_FIX8(15)){
 			tempballvel_y = tempballvel_y * -1;
 		}    
 	}  
-	return tempballpos_y; 
+	return FIX8_TO_INT(tempballpos_y); 
 }
+FIXMATH_HOT_END
 
 void normal_clock()
 {
@@ -1510,81 +1623,127 @@ void normal_clock()
 		if(c3==0) lastMinBuffer[0]=buffer[0];
 		if(c4==0) lastMinBuffer[1]=buffer[1];
 
-		matrix.swapBuffers(false); 
+		showFrame(false); 
 		Spark.process();	//Give the background process some lovin'
 	}
 }
 
 //Draw number n, with x,y as top left corner, in chosen color, scaled in x and y.
 //when scale_x, scale_y = 1 then character is 3x5
-void vectorNumber(int n, int x, int y, int color, float scale_x, float scale_y){
+void vectorNumber(int n, int x, int y, int color, float scale_x, float scale_y, Adafruit_GFX &gfx){
+	// The digits only ever end their lines at 0, 1 or 2 scale_x across and
+	// 0, 1, 2 or 4 scale_y down.  Work those out once, converted to pixels
+	// as drawLine()'s int16_t arguments always truncated them, and draw
+	// with integers; soft float on every end point of every line was most
+	// of the cost of a digit on the Core.
+	int16_t x1 = x + scale_x, x2 = x + 2 * scale_x,
+	        y1 = y + scale_y, y2 = y + 2 * scale_y, y4 = y + 4 * scale_y;
 
 	switch (n){
 	case 0:
-		matrix.drawLine(x ,y , x , y+(4*scale_y) , color);
-		matrix.drawLine(x , y+(4*scale_y) , x+(2*scale_x) , y+(4*scale_y), color);
-		matrix.drawLine(x+(2*scale_x) , y , x+(2*scale_x) , y+(4*scale_y) , color);
-		matrix.drawLine(x ,y , x+(2*scale_x) , y , color);
-		break; 
-	case 1: 
-		matrix.drawLine( x+(1*scale_x), y, x+(1*scale_x),y+(4*scale_y), color);  
-		matrix.drawLine(x , y+4*scale_y , x+2*scale_x , y+4*scale_y,color);
-		matrix.drawLine(x,y+scale_y, x+scale_x, y,color);
+		gfx.drawLine(x, y, x, y4, color);
+		gfx.drawLine(x, y4, x2, y4, color);
+		gfx.drawLine(x2, y, x2, y4, color);
+		gfx.drawLine(x, y, x2, y, color);
+		break;
+	case 1:
+		gfx.drawLine(x1, y, x1, y4, color);
+		gfx.drawLine(x, y4, x2, y4, color);
+		gfx.drawLine(x, y1, x1, y, color);
 		break;
 	case 2:
-		matrix.drawLine(x ,y , x+2*scale_x , y , color);
-		matrix.drawLine(x+2*scale_x , y , x+2*scale_x , y+2*scale_y , color);
-		matrix.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
-		matrix.drawLine(x , y+2*scale_y, x , y+4*scale_y,color);
-		matrix.drawLine(x , y+4*scale_y , x+2*scale_x , y+4*scale_y,color);
-		break; 
+		gfx.drawLine(x, y, x2, y, color);
+		gfx.drawLine(x2, y, x2, y2, color);
+		gfx.drawLine(x2, y2, x, y2, color);
+		gfx.drawLine(x, y2, x, y4, color);
+		gfx.drawLine(x, y4, x2, y4, color);
+		break;
 	case 3:
-		matrix.drawLine(x ,y , x+2*scale_x , y , color);
-		matrix.drawLine(x+2*scale_x , y , x+2*scale_x , y+4*scale_y , color);
-		matrix.drawLine(x+2*scale_x , y+2*scale_y , x+scale_x , y+2*scale_y, color);
-		matrix.drawLine(x , y+4*scale_y , x+2*scale_x , y+4*scale_y,color);
+		gfx.drawLine(x, y, x2, y, color);
+		gfx.drawLine(x2, y, x2, y4, color);
+		gfx.drawLine(x2, y2, x1, y2, color);
+		gfx.drawLine(x, y4, x2, y4, color);
 		break;
 	case 4:
-		matrix.drawLine(x+2*scale_x , y , x+2*scale_x , y+4*scale_y , color);
-		matrix.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
-		matrix.drawLine(x ,y , x , y+2*scale_y , color);
+		gfx.drawLine(x2, y, x2, y4, color);
+		gfx.drawLine(x2, y2, x, y2, color);
+		gfx.drawLine(x, y, x, y2, color);
 		break;
 	case 5:
-		matrix.drawLine(x ,y , x+2*scale_x , y , color);
-		matrix.drawLine(x , y , x , y+2*scale_y , color);
-		matrix.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
-		matrix.drawLine(x+2*scale_x , y+2*scale_y, x+2*scale_x , y+4*scale_y,color);
-		matrix.drawLine( x , y+4*scale_y , x+2*scale_x , y+4*scale_y,color);
-		break; 
+		gfx.drawLine(x, y, x2, y, color);
+		gfx.drawLine(x, y, x, y2, color);
+		gfx.drawLine(x2, y2, x, y2, color);
+		gfx.drawLine(x2, y2, x2, y4, color);
+		gfx.drawLine(x, y4, x2, y4, color);
+		break;
 	case 6:
-		matrix.drawLine(x ,y , x , y+(4*scale_y) , color);
-		matrix.drawLine(x ,y , x+2*scale_x , y , color);
-		matrix.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
-		matrix.drawLine(x+2*scale_x , y+2*scale_y, x+2*scale_x , y+4*scale_y,color);
-		matrix.drawLine(x+2*scale_x , y+4*scale_y , x, y+(4*scale_y) , color);
+		gfx.drawLine(x, y, x, y4, color);
+		gfx.drawLine(x, y, x2, y, color);
+		gfx.drawLine(x2, y2, x, y2, color);
+		gfx.drawLine(x2, y2, x2, y4, color);
+		gfx.drawLine(x2, y4, x, y4, color);
 		break;
 	case 7:
-		matrix.drawLine(x ,y , x+2*scale_x , y , color);
-		matrix.drawLine( x+2*scale_x, y, x+scale_x,y+(4*scale_y), color);
+		gfx.drawLine(x, y, x2, y, color);
+		gfx.drawLine(x2, y, x1, y4, color);
 		break;
 	case 8:
-		matrix.drawLine(x ,y , x , y+(4*scale_y) , color);
-		matrix.drawLine(x , y+(4*scale_y) , x+(2*scale_x) , y+(4*scale_y), color);
-		matrix.drawLine(x+(2*scale_x) , y , x+(2*scale_x) , y+(4*scale_y) , color);
-		matrix.drawLine(x ,y , x+(2*scale_x) , y , color);
-		matrix.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
+		gfx.drawLine(x, y, x, y4, color);
+		gfx.drawLine(x, y4, x2, y4, color);
+		gfx.drawLine(x2, y, x2, y4, color);
+		gfx.drawLine(x, y, x2, y, color);
+		gfx.drawLine(x2, y2, x, y2, color);
 		break;
 	case 9:
-		matrix.drawLine(x ,y , x , y+(2*scale_y) , color);
-		matrix.drawLine(x , y+(4*scale_y) , x+(2*scale_x) , y+(4*scale_y), color);
-		matrix.drawLine(x+(2*scale_x) , y , x+(2*scale_x) , y+(4*scale_y) , color);
-		matrix.drawLine(x ,y , x+(2*scale_x) , y , color);
-		matrix.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
-		break;    
+		gfx.drawLine(x, y, x, y2, color);
+		gfx.drawLine(x, y4, x2, y4, color);
+		gfx.drawLine(x2, y, x2, y4, color);
+		gfx.drawLine(x, y, x2, y, color);
+		gfx.drawLine(x2, y2, x, y2, color);
+		break;
 	}
 }
 
 
+
+//Render the hh mm readout used by pong, spectrum and plasma into the clock
+//overlay.  Only redrawn when the time or requested look actually changes.
+//colon: draw the two separator dots, box: opaque black backing.
+void updateClockOverlay(uint16_t color, boolean colon, boolean box)
+{
+	static int      lastMinute = -1, lastHour = -1;
+	static uint16_t lastColor = 0;
+	static boolean  lastColon = false, lastBox = false;
+	int mins = Time.minute();
+	int hours = Time.hour();
+
+	if (mins == lastMinute && hours == lastHour && color == lastColor &&
+			colon == lastColon && box == lastBox)
+		return;
+	lastMinute = mins;
+	lastHour = hours;
+	lastColor = color;
+	lastColon = colon;
+	lastBox = box;
+
+	if (box)
+		clockOverlay.setOpaque();
+	else
+		clockOverlay.setTransparent(0);
+	clockOverlay.fillScreen(0);
+
+	// Same layout the modes used to draw straight onto the matrix
+	vectorNumber(hours / 10, 8 - OVERLAY_X, 1 - OVERLAY_Y, color, 1, 1, clockOverlay);
+	vectorNumber(hours % 10, 12 - OVERLAY_X, 1 - OVERLAY_Y, color, 1, 1, clockOverlay);
+	vectorNumber(mins / 10, 18 - OVERLAY_X, 1 - OVERLAY_Y, color, 1, 1, clockOverlay);
+	vectorNumber(mins % 10, 22 - OVERLAY_X, 1 - OVERLAY_Y, color, 1, 1, clockOverlay);
+
+	if (colon) {
+		clockOverlay.drawPixel(16 - OVERLAY_X, 2 - OVERLAY_Y, color);
+		clockOverlay.drawPixel(16 - OVERLAY_X, 4 - OVERLAY_Y, color);
+	}
+}
+
 //print a clock using words rather than numbers
 void word_clock() {
 	DEBUGpln("in word_clock");
@@ -1725,7 +1884,7 @@ void word_clock() {
 				drawString(offset_mid,5,str_mid,(lenmid<6?53:51),matrix.Color333(1,1,5));
 			}
 			drawString(offset_bot,(lenmid>1?10:8),str_bot,(lenbot<6?53:51),matrix.Color333(0,5,1));    
-			matrix.swapBuffers(false);
+			showFrame(false);
 		}
 		Spark.process();	//Give the background process some lovin'
 		delay (50); 
@@ -1866,7 +2025,7 @@ void jumble() {
 						matrix.fillRect((seq[c]-x)*4,y,3,5,matrix.Color333(0,0,0));
 						drawChar((seq[c] - x) *4, y, allchars[random(0,36)],51,matrix.Color444(1,0,0));
 						counter[ seq[c] ]--;
-						matrix.swapBuffers(true);
+						showFrame(true);
 					}
 
 					//if counter == 1 then put final char 
@@ -1875,7 +2034,7 @@ void jumble() {
 						drawChar((seq[c] - x) *4, y, endchar[seq[c]],51,matrix.Color444(0,0,1));
 						counter[seq[c]] = 0;
 						alldone++;
-						matrix.swapBuffers(true);
+						showFrame(true);
 					} 
 
 					//if counter == 0 then just pause to keep update rate the same
@@ -2085,141 +2244,86 @@ void flashing_cursor(byte xpos, byte ypos, byte cursor_width, byte cursor_height
 }
 
 
-void drawString(int x, int y, char* c,uint8_t font_size, uint16_t color)
+void drawString(int x, int y, char* c,uint8_t font_size, uint16_t color, Adafruit_GFX &gfx)
 {
-	// x & y are positions, c-> pointer to string to disp, update_s: false(write to mem), true: write to disp
-	//font_size : 51(ascii value for 3), 53(5) and 56(8)
-	for(uint16_t i=0; i< strlen(c); i++)
-	{
-		drawChar(x, y, c[i],font_size, color);
-		x+=calc_font_displacement(font_size); // Width of each glyph
-	}
+	// x & y are positions, c-> pointer to string to disp, gfx: matrix or an offscreen strip
+	//font_size : 51(ascii value for 3) or 53(5)
+	// The caller's font, size, wrap and colors are put back afterwards
+	uint8_t  font = gfx.getFont(), size = gfx.getTextSize();
+	boolean  wrap = gfx.getTextWrap();
+	uint16_t fg = gfx.getTextColor(), bg = gfx.getTextBgColor();
+
+	gfx.setFont(font_size == 51 ? FONT_3X5 : FONT_5X5);
+	gfx.setTextSize(1);
+	gfx.setTextWrap(false);
+	gfx.setTextColor(color);
+	gfx.setCursor(x, y);
+	gfx.print(c);
+
+	gfx.setFont(font);
+	gfx.setTextSize(size);
+	gfx.setTextWrap(wrap);
+	gfx.setTextColor(fg, bg);
 }
 
 int calc_font_displacement(uint8_t font_size)
 {
-	switch(font_size)
-	{
-	case 51:
-		return 4;  //5x3 hence occupies 4 columns ( 3 + 1(space btw two characters))
-		break;
-
-	case 53:
-		return 6;
-		break;
-		//case 56:
-		//return 6;
-		//break;
-	default:
-		return 6;
-		break;
-	}
+	// Both fonts are monospaced: glyph width + 1 column between characters
+	return (font_size == 51 ? font3x5Descriptors : font5x5Descriptors)[0].width + 1;
 }
 
-void drawChar(int x, int y, char c, uint8_t font_size, uint16_t color)  // Display the data depending on the font size mentioned in the font_size variable
+void drawChar(int x, int y, char c, uint8_t font_size, uint16_t color, Adafruit_GFX &gfx)  // Display the data depending on the font size mentioned in the font_size variable
 {
+	uint8_t font = gfx.getFont();
 
-	uint8_t dots;
-	if ((c >= 'A' && c <= 'Z') ||
-			(c >= 'a' && c <= 'z')) {
-		c &= 0x1F;   // A-Z maps to 1-26
-	} 
-	else if (c >= '0' && c <= '9') {
-		c = (c - '0') + 27;
-	} 
-	else if (c == ' ') {
-		c = 0; // space
-	}
-	else if (c == '#'){
-		c=37;
-	}
-	else if (c=='/'){
-		c=37;
-	}
-
-	switch(font_size)
-	{
-	case 51:  // font size 3x5  ascii value of 3: 51
-
-		if(c==':'){
-			matrix.drawPixel(x+1,y+1,color);
-			matrix.drawPixel(x+1,y+3,color);
-		}
-		else if(c=='-'){
-			matrix.drawLine(x,y+2,3,0,color);
-		}
-		else if(c=='.'){
-			matrix.drawPixel(x+1,y+2,color);
-		}
-		else if(c==39 || c==44){
-			matrix.drawLine(x+1,y,2,0,color);
-			matrix.drawPixel(x+2,y+1,color);
-		}
-		else{
-			for (uint8_t row=0; row< 5; row++) {
-				dots = font3x5[(uint8_t)c][row];
-				for (uint8_t col=0; col < 3; col++) {
-					int x1=x;
-					int y1=y;
-					if (dots & (4>>col))
-					matrix.drawPixel(x1+col, y1+row, color);
-				}    
-			}
-		}
-		break;
-
-	case 53:  // font size 5x5   ascii value of 5: 53
-
-		if(c==':'){
-			matrix.drawPixel(x+2,y+1,color);
-			matrix.drawPixel(x+2,y+3,color);
-		}
-		else if(c=='-'){
-			matrix.drawLine(x+1,y+2,3,0,color);
-		}
-		else if(c=='.'){
-			matrix.drawPixel(x+2,y+2,color);
-		}
-		else if(c==39 || c==44){
-			matrix.drawLine(x+2,y,2,0,color);
-			matrix.drawPixel(x+4,y+1,color);
-		}
-		else{
-			for (uint8_t row=0; row< 5; row++) {
-				dots = font5x5[(uint8_t)c][row];
-				for (uint8_t col=0; col < 5; col++) {
-					int x1=x;
-					int y1=y;
-					if (dots & (64>>col))  // For some wierd reason I have the 5x5 font in such a way that.. last two bits are zero.. 
-					matrix.drawPixel(x1+col, y1+row, color);        
-				}
-			}
-		}          
-
-		break;
-	default:
-		break;
-	}
+	gfx.setFont(font_size == 51 ? FONT_3X5 : FONT_5X5);
+	gfx.drawFastChar(x, y, c, color, color, 1);	// Native fast path on the matrix
+	gfx.setFont(font);
 }
 
 
 //Spectrum Analyser stuff
+FIXMATH_HOT_BEGIN
 void spectrumDisplay(){
 #if defined (useFFT)
 
-	uint8_t static i = 0;
-	//static unsigned long tt = 0;
-	int16_t val;
+	const uint16_t *samples;
+	boolean  goertzel = (spectrumBands <= SPECTRUM_GOERTZEL_MAX), ready = false;
 
-	uint8_t  c;
-	uint16_t x,minLvl, maxLvl;
-	int      level, y, off;
+	uint8_t  c, p;
+	uint16_t x;
+	int      y, off;
 
 	DEBUGpln("in Spectrum");
 
 	off = 0;
 
+	// The background gradient never changes, so render it once and
+	// composite it each frame instead of drawing 16 lines per frame
+	static GFXcanvas444 *gradient = NULL;
+	if (gradient == NULL) {
+		gradient = new GFXcanvas444(SPECTRUM_COLUMNS, 16);
+		gradient->setOpaque();
+		for(int l=0; l<16;l++){
+			gradient->drawFastHLine(0,l,SPECTRUM_COLUMNS,matrix.Color444(16-l,0,l));
+		}
+	}
+
+	// A few bands come cheaper from Goertzel filters, a frame per 128
+	// samples; otherwise overlapped FFTs over log spaced bins 1-63 (DC
+	// left out), a frame per block
+	if (goertzel) {
+		spectrumGoertzel.begin(spectrumBands, MIC_RATE);
+		spectrumLevels.setHop(SPECTRUM_POINTS);
+	}
+	else {
+		spectrumLogMap(spectrumEdges, spectrumBands, 1, SPECTRUM_POINTS / 2);
+		spectrumHistory.reset();
+		spectrumLevels.setHop(SPECTRUM_HOP);
+	}
+
 	cls();
+	mic.begin(MIC_RATE);
 	//for (int show = 0; show < SHOWCLOCK ; show++) {
 	int showTime = Time.now();
 	
@@ -2228,68 +2332,51 @@ void spectrumDisplay(){
 		return;	
 		if(mode_quick){
 			mode_quick = false;
+			matrix.setOverlay(NULL);
+			mic.end();
 			display_date();
 			quickWeather();
 			spectrumDisplay();
 			return;
 		}
 
-		if (i < 128){
-			val = map(analogRead(MIC),0,4095,0,1023);
-			fftdata[i] = (val / 4) - 128;
-			im[i] = 0;
-			i++;   
+		updateClockOverlay(matrix.Color333(0,1,0), true, false);
+		matrix.setOverlay(&clockOverlay, OVERLAY_X, OVERLAY_Y);
+
+		// Render a frame each time the sampler completes a block, over
+		// the last 128 samples
+		if ((samples = mic.read()) != NULL) {
+			if (goertzel) {
+				ready = spectrumGoertzel.add(samples, SPECTRUM_HOP);
+			}
+			else {
+				spectrumHistory.add(samples, SPECTRUM_HOP);
+				ready = spectrumHistory.full();
+			}
+			mic.release();	// Copied; don't pause sampling while drawing
 		}
-		else {
-			//this could be done with the fix_fftr function without the im array.
-			fix_fft(fftdata,im,7,0);
-			//fix_fftr(fftdata,7,0);
-			
-			// I am only interessted in the absolute value of the transformation
-			for (i=0; i< 64;i++){
-				fftdata[i] = sqrt(fftdata[i] * fftdata[i] + im[i] * im[i]); 
-				//ftdata[i] = sqrt(fftdata[i] * fftdata[i] + fftdata[i+64] * fftdata[i+64]); 
+		if (samples && ready) {
+			// Band levels: Goertzel filters, or window, FFT and magnitudes
+			// and then the loudest bin of each (log spaced) band
+			if (goertzel) {
+				spectrumGoertzel.levels(spectrum);
 			}
-
-			for (i=0; i< 32;i++){
-				spectrum[i] = fftdata[i*2] + fftdata[i*2 + 1];   // average together 
+			else {
+				spectrumHistory.magnitudes(fftdata, fftWindow);
+				spectrumColumns(fftdata, spectrumEdges, spectrumBands, spectrum);
 			}
+			// Spread the bands over the columns, then auto-gain them into
+			// column heights
+			spectrumSpread(spectrum, spectrumBands);
+			spectrumLevels.update(spectrum);
 
-			for(int l=0; l<16;l++){
-				int col = matrix.Color444(16-l,0,l);
-				matrix.drawLine(0,l,31,l,col);
-			}
+			matrix.drawCanvas(0,0,*gradient);
 
-			// Downsample spectrum output to 32 columns:
-			for(x=0; x<32; x++) {
-				col[x][colCount] = spectrum[x];
-				
-				minLvl = maxLvl = col[x][0];
-				int colsum=col[x][0];
-				for(i=1; i<10; i++) { // Get range of prior 10 frames
-					if(i<10)colsum = colsum + col[x][i];
-					if(col[x][i] < minLvl)      minLvl = col[x][i];
-					else if(col[x][i] > maxLvl) maxLvl = col[x][i];
-				}
-				// minLvl and maxLvl indicate the extents of the FFT output, used
-				// for vertically scaling the output graph (so it looks interesting
-				// regardless of volume level).  If they're too close together though
-				// (e.g. at very low volume levels) the graph becomes super coarse
-				// and 'jumpy'...so keep some minimum distance between them (this
-				// also lets the graph go to zero when no sound is playing):
-				if((maxLvl - minLvl) < 16) maxLvl = minLvl + 8;
-				minLvlAvg[x] = (minLvlAvg[x] * 7 + minLvl) >> 3; // Dampen min/max levels
-				maxLvlAvg[x] = (maxLvlAvg[x] * 7 + maxLvl) >> 3; // (fake rolling average)
-
-				level = col[x][colCount];
-				// Clip output and convert to byte:
-				if(level < 0L)      c = 0;
-				else if(level > 18) c = 18; // Allow dot to go a couple pixels off top
-				else                c = (uint8_t)level;
-
-				if(c > peak[x]) peak[x] = c; // Keep dot on top
-
-				if(peak[x] <= 0) { // Empty column?
+			for(x=0; x<SPECTRUM_COLUMNS; x++) {
+				c = spectrumLevels.height(x);
+				p = spectrumLevels.peak(x);
+
+				if(p <= 0) { // Empty column?
 					matrix.drawLine(x, 0, x, 15, off);
 					continue;
 				}
@@ -2299,67 +2386,40 @@ void spectrumDisplay(){
 
 				// The 'peak' dot color varies, but doesn't necessarily match
 				// the three screen regions...yellow has a little extra influence.
-				y = 16 - peak[x];
-				matrix.drawPixel(x,y,matrix.Color444(peak[x],0,16-peak[x]));
+				y = 16 - p;
+				matrix.drawPixel(x,y,matrix.Color444(p,0,16-p));
 			}
-			i=0;
-		}
-
-		int mins = Time.minute();
-		int hours = Time.hour();
-
-		char buffer[3];
-
-		itoa(hours,buffer,10);
-		//fix - as otherwise if num has leading zero, e.g. "03" hours, itoa coverts this to chars with space "3 ". 
-		if (hours < 10) {
-			buffer[1] = buffer[0];
-			buffer[0] = '0';
-		}
-		vectorNumber(buffer[0]-'0',8,1,matrix.Color333(0,1,0),1,1);
-		vectorNumber(buffer[1]-'0',12,1,matrix.Color333(0,1,0),1,1);
 
-		itoa(mins,buffer,10);
-		//fix - as otherwise if num has leading zero, e.g. "03" hours, itoa coverts this to chars with space "3 ". 
-		if (mins < 10) {
-			buffer[1] = buffer[0];
-			buffer[0] = '0';
+			showFrame(true);
 		}
-		vectorNumber(buffer[0]-'0',18,1,matrix.Color333(0,1,0),1,1);
-		vectorNumber(buffer[1]-'0',22,1,matrix.Color333(0,1,0),1,1);
-
-		matrix.drawPixel(16,2,matrix.Color333(0,1,0));
-		matrix.drawPixel(16,4,matrix.Color333(0,1,0));
-
-		matrix.swapBuffers(true);
-		//delay(10);
-
-
-		// Every third frame, make the peak pixels drop by 1:
-		if(++dotCount >= 3) {
-			dotCount = 0;
-			for(x=0; x<32; x++) {
-				if(peak[x] > 0) peak[x]--;
-			}
-		}
-
-		if(++colCount >= 10) colCount = 0;
 		
 		Spark.process();	//Give the background process some lovin'
 	}
 
 #endif
 }
+FIXMATH_HOT_END
 
 
+FIXMATH_HOT_BEGIN
 void plasma()
 {
-	int           x1, x2, x3, x4, y1, y2, y3, y4, sx1, sx2, sx3, sx4;
-	unsigned char x, y;
-	long          value;
-	unsigned long slowFrameRate = millis();
+	uint8_t       row[64];	// One row of hue indices; the panel is at most 64 wide
+	rgb444_t      colors[64];	// The same row in direct color
+	unsigned char x, y, r, scale;
+	unsigned int  hueTime = 0;	// ms not yet turned into hue steps
+	boolean       indexed;
 	
+	// The plasma field goes into the index buffer and the hue shift is
+	// applied by rotating the palette.  Falls back to direct color if
+	// there isn't RAM for indexed mode.
+	matrix.setHuePalette(255, 255, true);
+	indexed = matrix.setIndexed(true);
 	cls();
+#if defined useFFT
+	audio.begin(MIC_RATE);	// Kick the hues on each onset in the music
+#endif
+	framePacer.begin();
 	
 	//for (int show = 0; show < SHOWCLOCK ; show++) {
 	int showTime = Time.now();
@@ -2369,86 +2429,70 @@ void plasma()
 		return;	
 		if(mode_quick){
 			mode_quick = false;
+			matrix.setOverlay(NULL);
+			matrix.setIndexed(false);
+#if defined useFFT
+			audio.end();
+#endif
 			display_date();
 			quickWeather();
 			spectrumDisplay();
 			return;
 		}
 		
-		if (millis() - slowFrameRate >= 150) {
-			
-			sx1 = (int)(cos(angle1) * radius1 + centerx1);
-			sx2 = (int)(cos(angle2) * radius2 + centerx2);
-			sx3 = (int)(cos(angle3) * radius3 + centerx3);
-			sx4 = (int)(cos(angle4) * radius4 + centerx4);
-			y1  = (int)(sin(angle1) * radius1 + centery1);
-			y2  = (int)(sin(angle2) * radius2 + centery2);
-			y3  = (int)(sin(angle3) * radius3 + centery3);
-			y4  = (int)(sin(angle4) * radius4 + centery4);
-
-			for(y=0; y<(matrix.height()); y++) {
-				x1 = sx1; x2 = sx2; x3 = sx3; x4 = sx4;
-				for(x=0; x<matrix.width(); x++) {
-					value = hueShift
-					+ (int8_t)pgm_read_byte(sinetab + (uint8_t)((x1 * x1 + y1 * y1) >> 4))
-					+ (int8_t)pgm_read_byte(sinetab + (uint8_t)((x2 * x2 + y2 * y2) >> 4))
-					+ (int8_t)pgm_read_byte(sinetab + (uint8_t)((x3 * x3 + y3 * y3) >> 5))
-					+ (int8_t)pgm_read_byte(sinetab + (uint8_t)((x4 * x4 + y4 * y4) >> 5));
-					matrix.drawPixel(x, y, matrix.ColorHSV(value * 3, 255, 255, true));
-					x1--; x2--; x3--; x4--;
-				}
-				y1--; y2--; y3--; y4--;
-			}
+		updateClockOverlay(matrix.Color333(229,0,0), true, true);
+		matrix.setOverlay(&clockOverlay, OVERLAY_X, OVERLAY_Y);
 
-			angle1 += 0.03;
-			angle2 -= 0.07;
-			angle3 += 0.13;
-			angle4 -= 0.15;
-			hueShift += 2;
+#if defined useFFT
+		audio.update();
+		if (audio.onset())
+			hueShift += 32;
+#endif
 
-			matrix.fillRect(7, 0, 19, 7, 0);
+		// Everything moves by time, so the speed is the same at any frame
+		// rate; when frames take too long, render every 2nd or 4th pixel
+		if (framePacer.due()) {
 			
-			int mins = Time.minute();
-			int hours = Time.hour();
-			char buffer[3];
-
-			itoa(hours,buffer,10);
-			//fix - as otherwise if num has leading zero, e.g. "03" hours, itoa coverts this to chars with space "3 ". 
-			if (hours < 10) {
-				buffer[1] = buffer[0];
-				buffer[0] = '0';
+			plasmaField.nextFrame(framePacer.elapsed());
+			scale = framePacer.scale();
+			for(y=0; y<(matrix.height()); y+=scale) {
+				plasmaField.renderRow(y, row, matrix.width(), scale);
+				if (!indexed)
+					for(x=0; x<matrix.width(); x++)
+						colors[x] = RGBmatrixPanel::RGB444(matrix.huePalette((2 * row[x] + hueShift) * 3));
+				for(r=y; r<y+scale && r<matrix.height(); r++) {
+					if (indexed)
+						matrix.drawIndexRow(r, row);
+					else
+						matrix.drawRow(r, colors);
+				}
 			}
-			vectorNumber(buffer[0]-'0',8,1,matrix.Color333(229,0,0),1,1);
-			vectorNumber(buffer[1]-'0',12,1,matrix.Color333(229,0,0),1,1);
 
-			itoa(mins,buffer,10);
-			//fix - as otherwise if num has leading zero, e.g. "03" hours, itoa coverts this to chars with space "3 ". 
-			if (mins < 10) {
-				buffer[1] = buffer[0];
-				buffer[0] = '0';
-			}
-			vectorNumber(buffer[0]-'0',18,1,matrix.Color333(229,0,0),1,1);
-			vectorNumber(buffer[1]-'0',22,1,matrix.Color333(229,0,0),1,1);
+			// Palette entry i shows hue step 2 * i, shifted
+			if (indexed)
+				for (int i = 0; i < 256; i++)
+					matrix.setPaletteColor(i, matrix.huePalette((2 * i + hueShift) * 3));
 
-			matrix.drawPixel(16,2,matrix.Color333(229,0,0));
-			matrix.drawPixel(16,4,matrix.Color333(229,0,0));
-			
-			matrix.swapBuffers(false);
-			
-			slowFrameRate = millis();
+			hueTime += 2 * framePacer.elapsed();	// 2 hue steps per PLASMA_FRAME_MS
+			hueShift += hueTime / PLASMA_FRAME_MS;
+			hueTime %= PLASMA_FRAME_MS;
+
+			showFrame(false);
+			framePacer.done();
+			frameRate = framePacer.fps();
 		}
 		Spark.process();	//Give the background process some lovin'
-		delay(30);
 	}
 }
+FIXMATH_HOT_END
 
 void marquee()
 {
 	char topLine[40] = {""};
 #ifdef USING_SPECIAL_MESSAGES
-  	char* botmLine = getMessageOfTheDay();
+  	char* botmLine = getMessageOfTheDay();	// Up to STRIP_CHARS characters are shown
 #else
-  	char botmLine[40] = "INSERT YOUR SPECIAL MESSAGE HERE";
+  	char botmLine[STRIP_CHARS + 1] = "INSERT YOUR SPECIAL MESSAGE HERE";
 #endif
 	String tFull;
 	
@@ -86,6 +86,11 @@ BSD license, all text above must be included in any redistribution.
 
 #define nPlanes 4
 
+// Gamma correction, 8-bit input to nPlanes-bit output, generated at
+// compile time (see gamma.h).  Brightness (GAMMA_BRIGHTNESS) is folded
+// into the same table, so it costs nothing per pixel.
+static const uint8_t (&gamma)[256] = GammaTable<nPlanes>::table;
+
 //Define hardware IntervalTimer
 IntervalTimer refreshTimer;
 
@@ -128,6 +133,13 @@ void RGBmatrixPanel::init(uint8_t rows, uint8_t a, uint8_t b, uint8_t c,
   row       = nRows   - 1;
   swapflag  = false;
   backindex = 0;     // Array index of back buffer
+  overlay   = NULL;  // No overlay layer
+  hueTable  = NULL;  // Hue palette is allocated on first use
+  hueSat    = 255;
+  hueVal    = 255;
+  hueGamma  = true;
+  indexBuf  = NULL;  // Indexed mode is allocated on first use
+  indexed   = false;
 }
 
 // Constructor for 16x32 panel:
@@ -213,7 +225,7 @@ uint16_t RGBmatrixPanel::Color888(uint8_t r, uint8_t g, uint8_t b) {
 uint16_t RGBmatrixPanel::Color888(
   uint8_t r, uint8_t g, uint8_t b, boolean gflag) {
   if(gflag) { // Gamma-corrected color?
-    r = gamma[r]; // Gamma correction table maps
+    r = gamma[r]; // Gamma (and brightness) table maps
     g = gamma[g]; // 8-bit input to 4-bit output
     b = gamma[b];
     return ((uint16_t)r << 12) | ((uint16_t)(r & 0x8) << 8) | // 4/4/4->5/6/5
@@ -254,7 +266,7 @@ uint16_t RGBmatrixPanel::ColorHSV(
   // to allow shifts, and upgrade to int makes other conversions implicit.
   v1 = val + 1;
   if(gflag) { // Gamma-corrected color?
-    r = gamma[(r * v1) >> 8]; // Gamma correction table maps
+    r = gamma[(r * v1) >> 8]; // Gamma (and brightness) table maps
     g = gamma[(g * v1) >> 8]; // 8-bit input to 4-bit output
     b = gamma[(b * v1) >> 8];
   } else { // linear (uncorrected) color
@@ -267,8 +279,69 @@ uint16_t RGBmatrixPanel::ColorHSV(
          (b <<  1) | ( b        >> 3);
 }
 
+// Precompute ColorHSV() for every hue at a fixed saturation, value and
+// gamma setting, so effects that sweep the color wheel (e.g. plasma) can
+// look colors up with huePalette() instead of redoing the sextant math,
+// multiplies and gamma lookups per pixel.  The 1536-entry (3 KB) table is
+// allocated on first use and only rebuilt when the settings change.
+void RGBmatrixPanel::setHuePalette(uint8_t sat, uint8_t val, boolean gflag) {
+  if(hueTable) {
+    if((sat == hueSat) && (val == hueVal) && (gflag == hueGamma)) return;
+  } else {
+    hueTable = (uint16_t *)malloc(1536 * sizeof(uint16_t));
+  }
+
+  hueSat   = sat;
+  hueVal   = val;
+  hueGamma = gflag;
+  if(hueTable) {
+    for(uint16_t h=0; h<1536; h++) hueTable[h] = ColorHSV(h, sat, val, gflag);
+  }
+}
+
+// Same result as ColorHSV(hue, sat, val, gflag) with the values last
+// passed to setHuePalette()
+uint16_t RGBmatrixPanel::huePalette(long hue) {
+  hue %= 1536;             // -1535 to +1535
+  if(hue < 0) hue += 1536; //     0 to +1535
+  if(!hueTable) return ColorHSV(hue, hueSat, hueVal, hueGamma); // No RAM
+  return hueTable[hue];
+}
+
+// Adafruit_GFX uses 16-bit color in 5/6/5 format, while matrix needs
+// 4/4/4.  The 5/6/5 entry points convert once per call and hand off to
+// the native versions further down.
 void RGBmatrixPanel::drawPixel(int16_t x, int16_t y, uint16_t c) {
-  uint8_t r, g, b, bit, limit, *ptr;
+  drawPixel(x, y, RGB444(c));
+}
+
+void RGBmatrixPanel::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  uint16_t c) {
+  drawLine(x0, y0, x1, y1, RGB444(c));
+}
+
+void RGBmatrixPanel::drawFastVLine(int16_t x, int16_t y, int16_t h,
+  uint16_t c) {
+  drawLine(x, y, x, y+h-1, RGB444(c));
+}
+
+void RGBmatrixPanel::drawFastHLine(int16_t x, int16_t y, int16_t w,
+  uint16_t c) {
+  drawLine(x, y, x+w-1, y, RGB444(c));
+}
+
+void RGBmatrixPanel::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+  uint16_t c) {
+  fillRect(x, y, w, h, RGB444(c));
+}
+
+// Text through print() ends up here
+void RGBmatrixPanel::drawFastChar(int16_t x, int16_t y, unsigned char c,
+  uint16_t color, uint16_t bg, uint8_t size) {
+  drawChar(x, y, c, RGB444(color), RGB444(bg), size);
+}
+
+void RGBmatrixPanel::drawPixel(int16_t x, int16_t y, rgb444_t c) {
 
   if((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
 
@@ -287,11 +360,130 @@ void RGBmatrixPanel::drawPixel(int16_t x, int16_t y, uint16_t c) {
     break;
   }
 
-  // Adafruit_GFX uses 16-bit color in 5/6/5 format, while matrix needs
-  // 4/4/4.  Pluck out relevant bits while separating into R,G,B:
-  r =  c >> 12;        // RRRRrggggggbbbbb
-  g = (c >>  7) & 0xF; // rrrrrGGGGggbbbbb
-  b = (c >>  1) & 0xF; // rrrrrggggggBBBBb
+  writePixel(x, y, c.rgb >> 8, (c.rgb >> 4) & 0xF, c.rgb & 0xF);
+}
+
+// Bresenham's algorithm, as Adafruit_GFX::drawLine()
+void RGBmatrixPanel::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+  rgb444_t c) {
+  if(x0 == x1) {
+    if(y0 > y1) swap(y0, y1);
+    fillRect(x0, y0, 1, y1 - y0 + 1, c);
+    return;
+  }
+  if(y0 == y1) {
+    if(x0 > x1) swap(x0, x1);
+    fillRect(x0, y0, x1 - x0 + 1, 1, c);
+    return;
+  }
+
+  int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+  if(steep) {
+    swap(x0, y0);
+    swap(x1, y1);
+  }
+  if(x0 > x1) {
+    swap(x0, x1);
+    swap(y0, y1);
+  }
+
+  int16_t dx = x1 - x0, dy = abs(y1 - y0), err = dx / 2,
+          ystep = (y0 < y1) ? 1 : -1;
+
+  for(; x0<=x1; x0++) {
+    if(steep) drawPixel(y0, x0, c);
+    else      drawPixel(x0, y0, c);
+    err -= dy;
+    if(err < 0) {
+      y0  += ystep;
+      err += dx;
+    }
+  }
+}
+
+// Like the Adafruit_GFX versions these are lines from (x,y) to the far
+// end, so a zero or negative length draws backwards
+void RGBmatrixPanel::drawFastVLine(int16_t x, int16_t y, int16_t h,
+  rgb444_t c) {
+  drawLine(x, y, x, y+h-1, c);
+}
+
+void RGBmatrixPanel::drawFastHLine(int16_t x, int16_t y, int16_t w,
+  rgb444_t c) {
+  drawLine(x, y, x+w-1, y, c);
+}
+
+void RGBmatrixPanel::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+  rgb444_t c) {
+  drawFastHLine(x, y, w, c);
+  drawFastHLine(x, y+h-1, w, c);
+  drawFastVLine(x, y, h, c);
+  drawFastVLine(x+w-1, y, h, c);
+}
+
+// Clipped once, then written straight into the bit planes
+void RGBmatrixPanel::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+  rgb444_t c) {
+  int16_t i, j, i0, i1, j0, j1;
+
+  if(h <= 0) { // Adafruit_GFX::fillRect() draws these columns upward
+    y += h - 1;
+    h  = 2 - h;
+  }
+
+  i0 = (x < 0) ? -x : 0;  i1 = (x + w > _width)  ? _width  - x : w;
+  j0 = (y < 0) ? -y : 0;  j1 = (y + h > _height) ? _height - y : h;
+
+  uint8_t r = c.rgb >> 8, g = (c.rgb >> 4) & 0xF, b = c.rgb & 0xF;
+  for(j=j0; j<j1; j++) {
+    for(i=i0; i<i1; i++) {
+      if(rotation) drawPixel(x + i, y + j, c);  // Rare
+      else         writePixel(x + i, y + j, r, g, b);
+    }
+  }
+}
+
+// Same as Adafruit_GFX::drawChar(), but any glyph that lies wholly on
+// screen is written straight into the bit planes
+void RGBmatrixPanel::drawChar(int16_t x, int16_t y, unsigned char c,
+  rgb444_t color, rgb444_t bg, uint8_t size) {
+
+  c = (c < fontStart || c > fontEnd) ? 0 : c - fontStart;
+
+  int16_t w = fontDesc[c].width, h = fontDesc[c].height, i, j;
+  if((x >= _width) || (y >= _height) ||
+     ((x + w * size - 1) < 0) || ((y + h * size - 1) < 0))
+    return;
+
+  boolean opaque = (bg.rgb != color.rgb),
+          direct = !rotation && (size == 1) && (x >= 0) && (y >= 0) &&
+                   (x + w <= _width) && (y + h <= _height);
+  uint8_t r  = color.rgb >> 8, g  = (color.rgb >> 4) & 0xF, b  = color.rgb & 0xF,
+          br = bg.rgb    >> 8, bgr = (bg.rgb   >> 4) & 0xF, bb = bg.rgb    & 0xF;
+  GlyphCursor glyph;
+  glyphBegin(glyph, c);
+
+  for(i=0; i<h; i++) {
+    for(j=0; j<w; j++) {
+      if(glyphPixel(glyph)) {
+        if(direct)         writePixel(x + j, y + i, r, g, b);
+        else if(size == 1) drawPixel(x + j, y + i, color);
+        else               fillRect(x + j * size, y + i * size, size, size, color);
+      } else if(opaque) {
+        if(direct)         writePixel(x + j, y + i, br, bgr, bb);
+        else if(size == 1) drawPixel(x + j, y + i, bg);
+        else               fillRect(x + j * size, y + i * size, size, size, bg);
+      }
+    }
+    glyphRowEnd(glyph);
+  }
+}
+
+// Store one 4/4/4 pixel into the back buffer's bit planes.  x and y are
+// raw (unrotated) coordinates and must already be clipped.
+inline void RGBmatrixPanel::writePixel(int16_t x, int16_t y,
+  uint8_t r, uint8_t g, uint8_t b) {
+  uint8_t bit, limit, *ptr;
 
   // Loop counter stuff
   bit   = 2;
@@ -337,15 +529,79 @@ void RGBmatrixPanel::drawPixel(int16_t x, int16_t y, uint16_t c) {
   }
 }
 
+// Composite a 1-bit canvas at (x,y): set bits are drawn in color 'c',
+// clear bits leave the back buffer untouched.
+void RGBmatrixPanel::drawCanvas(int16_t x, int16_t y, GFXcanvas1 &canvas,
+  uint16_t c) {
+  if(canvas.getBuffer())
+    drawBitmap(x, y, canvas.getBuffer(), canvas.width(), canvas.height(), c);
+}
+
+// Same result as Adafruit_GFX::drawBitmap(), but clipped once and written
+// straight into the bit planes instead of going through drawPixel().
+void RGBmatrixPanel::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+  int16_t w, int16_t h, uint16_t c) {
+  drawBitmap(x, y, bitmap, w, h, RGB444(c));
+}
+
+void RGBmatrixPanel::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+  int16_t w, int16_t h, rgb444_t c) {
+  int16_t byteWidth = (w + 7) / 8, i, j, i0, i1, j0, j1;
+
+  // Clip once up front rather than per pixel
+  i0 = (x < 0) ? -x : 0;  i1 = (x + w > _width)  ? _width  - x : w;
+  j0 = (y < 0) ? -y : 0;  j1 = (y + h > _height) ? _height - y : h;
+
+  uint8_t r = c.rgb >> 8, g = (c.rgb >> 4) & 0xF, b = c.rgb & 0xF;
+  for(j=j0; j<j1; j++) {
+    for(i=i0; i<i1; i++) {
+      if(bitmap[j * byteWidth + (i >> 3)] & (0x80 >> (i & 7))) {
+        if(rotation) drawPixel(x + i, y + j, c);  // Rare
+        else         writePixel(x + i, y + j, r, g, b);
+      }
+    }
+  }
+}
+
+// Composite a 4/4/4 canvas at (x,y), skipping its transparent pixels.
+// Canvas data is already at the matrix's depth, so this is a single pass
+// with no color conversion.
+void RGBmatrixPanel::drawCanvas(int16_t x, int16_t y, GFXcanvas444 &canvas) {
+  uint16_t *buf = canvas.getBuffer(), key = canvas.getTransparent(), p;
+  int16_t   w = canvas.width(), h = canvas.height(), i, j, i0, i1, j0, j1;
+
+  if(!buf) return;
+
+  i0 = (x < 0) ? -x : 0;  i1 = (x + w > _width)  ? _width  - x : w;
+  j0 = (y < 0) ? -y : 0;  j1 = (y + h > _height) ? _height - y : h;
+
+  for(j=j0; j<j1; j++) {
+    uint16_t *row = &buf[j * w];
+    for(i=i0; i<i1; i++) {
+      if((p = row[i]) == key) continue;
+      if(rotation) {
+        rgb444_t n = { p };
+        drawPixel(x + i, y + j, n);
+      } else {
+        writePixel(x + i, y + j, p >> 8, (p >> 4) & 0xF, p & 0xF);
+      }
+    }
+  }
+}
+
 void RGBmatrixPanel::fillScreen(uint16_t c) {
-  if((c == 0x0000) || (c == 0xffff)) {
+  fillScreen(RGB444(c));
+}
+
+void RGBmatrixPanel::fillScreen(rgb444_t c) {
+  if((c.rgb == 0x000) || (c.rgb == 0xfff)) {
     // For black or white, all bits in frame buffer will be identically
     // set or unset (regardless of weird bit packing), so it's OK to just
     // quickly memset the whole thing:
-    memset(matrixbuff[backindex], c, WIDTH * nRows * 3);
+    memset(matrixbuff[backindex], c.rgb ? 0xff : 0x00, WIDTH * nRows * 3);
   } else {
     // Otherwise, need to handle it the long way:
-    Adafruit_GFX::fillScreen(c);
+    fillRect(0, 0, _width, _height, c);
   }
 }
 
@@ -354,13 +610,289 @@ uint8_t *RGBmatrixPanel::backBuffer() {
   return matrixbuff[backindex];
 }
 
+// Address of the buffer being displayed (same as backBuffer() if not
+// double-buffered).  Treat it as read-only.
+uint8_t *RGBmatrixPanel::frontBuffer() {
+  return matrixbuff[1 - backindex];
+}
+
+// Whole-buffer operations on the packed bit planes.  Each group of three
+// plane bytes (p, p+WIDTH, p+WIDTH*2) holds the 4-bit R,G,B of one upper
+// and one lower half pixel; these unpack them into six channel values
+// and back, so the operations below can work per channel through small
+// lookup tables rather than per pixel through drawPixel().  Buffers are
+// WIDTH * nRows * 3 bytes, e.g. backBuffer(), frontBuffer() or a copy of
+// one, and results always go to the back buffer (which may also be a
+// source).
+
+// c[] = upper R,G,B, lower R,G,B
+static inline void unpackPlanes(const uint8_t *p, int16_t w, uint8_t c[6]) {
+  uint8_t b0 = p[0], b1 = p[w], b2 = p[w*2],
+          p0 = (b2 & 3) | ((b1 & 3) << 2) | ((b0 & 3) << 4); // Plane 0
+
+  b0 >>= 2; b1 >>= 2; b2 >>= 2;                              // Planes 1-3
+  for(uint8_t i=0; i<6; i++) {
+    c[i] = (p0 & 1) | ((b0 & 1) << 1) | ((b1 & 1) << 2) | ((b2 & 1) << 3);
+    p0 >>= 1; b0 >>= 1; b1 >>= 1; b2 >>= 1;
+  }
+}
+
+static inline void packPlanes(uint8_t *p, int16_t w, const uint8_t c[6]) {
+  uint8_t p0 = 0, b0 = 0, b1 = 0, b2 = 0;
+
+  for(uint8_t i=6; i--; ) {
+    p0 = (p0 << 1) | ( c[i]       & 1);
+    b0 = (b0 << 1) | ((c[i] >> 1) & 1);
+    b1 = (b1 << 1) | ((c[i] >> 2) & 1);
+    b2 = (b2 << 1) | ((c[i] >> 3) & 1);
+  }
+  p[0]   = (b0 << 2) |  (p0 >> 4);
+  p[w]   = (b1 << 2) | ((p0 >> 2) & 3);
+  p[w*2] = (b2 << 2) |  (p0       & 3);
+}
+
+// Back buffer = src scaled by level (255 = unchanged, 0 = black).  Fading
+// the front buffer into the back buffer repeatedly (then swapping) fades
+// the screen to black; any level below 255 reaches black in at most 15
+// steps.
+void RGBmatrixPanel::fadeBuffer(const uint8_t *src, uint8_t level) {
+  uint8_t  scale[16], c[6], *dst = matrixbuff[backindex];
+  uint16_t v1 = level + 1, i;
+
+  for(i=0; i<16; i++) scale[i] = (i * v1) >> 8;
+  for(uint8_t y=0; y<nRows; y++) {
+    for(int16_t x=0; x<WIDTH; x++) {
+      unpackPlanes(src, WIDTH, c);
+      for(i=0; i<6; i++) c[i] = scale[c[i]];
+      packPlanes(dst, WIDTH, c);
+      src++;
+      dst++;
+    }
+    src += WIDTH * 2; // Skip the other two planes of this row
+    dst += WIDTH * 2;
+  }
+}
+
+// Back buffer = a * (1 - alpha) + b * alpha, alpha 0 - 255 (all a to
+// all b), rounded.  For a cross-fade, keep a copy of the incoming frame
+// in 'b' and step alpha up over a few frames.
+void RGBmatrixPanel::blendBuffers(const uint8_t *a, const uint8_t *b,
+  uint8_t alpha) {
+  uint16_t wa[16], wb[16], a1 = alpha + (alpha >> 7), i; // a1 = 0 - 256
+  uint8_t  ca[6], cb[6], *dst = matrixbuff[backindex];
+
+  for(i=0; i<16; i++) {
+    wa[i] = i * (256 - a1);
+    wb[i] = i * a1;
+  }
+  for(uint8_t y=0; y<nRows; y++) {
+    for(int16_t x=0; x<WIDTH; x++) {
+      unpackPlanes(a, WIDTH, ca);
+      unpackPlanes(b, WIDTH, cb);
+      for(i=0; i<6; i++) ca[i] = (wa[ca[i]] + wb[cb[i]] + 128) >> 8;
+      packPlanes(dst, WIDTH, ca);
+      a++;
+      b++;
+      dst++;
+    }
+    a   += WIDTH * 2;
+    b   += WIDTH * 2;
+    dst += WIDTH * 2;
+  }
+}
+
+// Back buffer += src, per channel, saturating at full brightness
+void RGBmatrixPanel::addBuffer(const uint8_t *src) {
+  static const uint8_t saturate[31] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15 };
+  uint8_t cs[6], cd[6], *dst = matrixbuff[backindex];
+
+  for(uint8_t y=0; y<nRows; y++) {
+    for(int16_t x=0; x<WIDTH; x++) {
+      unpackPlanes(src, WIDTH, cs);
+      unpackPlanes(dst, WIDTH, cd);
+      for(uint8_t i=0; i<6; i++) cd[i] = saturate[cd[i] + cs[i]];
+      packPlanes(dst, WIDTH, cd);
+      src++;
+      dst++;
+    }
+    src += WIDTH * 2;
+    dst += WIDTH * 2;
+  }
+}
+
+// Palette-indexed mode: drawing goes into an 8-bit buffer, one byte per
+// pixel (raw WIDTH x HEIGHT, row major, unrotated), and each byte picks
+// one of 256 palette colors.  swapBuffers() resolves the whole buffer
+// into the bit planes, so color-cycling effects animate by rewriting the
+// palette with setPaletteColor() instead of redrawing pixels, and the
+// per-pixel color conversion and bit plane masking is replaced by one
+// palette lookup per pixel.  The normal drawing calls still write
+// the back buffer directly but are overwritten at the next swap; the
+// overlay is composited after resolving, as usual.  The index buffer and
+// palette (WIDTH * HEIGHT + 1.5 KB) are allocated on first use and kept.
+// Returns false if there is not enough RAM.
+boolean RGBmatrixPanel::setIndexed(boolean on) {
+  if(on && !indexBuf) {
+    int buffsize = WIDTH * HEIGHT;
+    if(NULL == (indexBuf = (uint8_t *)malloc(buffsize + 256 * 6)))
+      return false;
+    memset(indexBuf, 0, buffsize + 256 * 6); // All black
+    paletteBits = (uint8_t (*)[6])&indexBuf[buffsize];
+  }
+  indexed = on;
+  return true;
+}
+
+// Raw index buffer, or NULL if indexed mode was never enabled
+uint8_t *RGBmatrixPanel::indexBuffer() {
+  return indexBuf;
+}
+
+void RGBmatrixPanel::setPaletteColor(uint8_t i, uint16_t c) {
+  setPaletteColor(i, RGB444(c));
+}
+
+void RGBmatrixPanel::setPaletteColor(uint8_t i, rgb444_t c) {
+  if(!indexBuf) return;
+  planeBytes(c, paletteBits[i]);
+}
+
+// Split a 4/4/4 color into its plane bytes, following the layout
+// writePixel() uses: p[0..2] for an upper-half pixel, p[3..5] for a
+// lower-half one.
+void RGBmatrixPanel::planeBytes(rgb444_t c, uint8_t *p) {
+  uint8_t r = c.rgb >> 8, g = (c.rgb >> 4) & 0xF, b = c.rgb & 0xF;
+
+  // Planes 1-3 in bits 2-4, plane 0 R,G in the 3rd byte and B in the 2nd
+  p[0] = ((r & 2) << 1) | ((g & 2) << 2) | ((b & 2) << 3);
+  p[1] =  (r & 4)       | ((g & 4) << 1) | ((b & 4) << 2) |  (b & 1);
+  p[2] = ((r & 8) >> 1) |  (g & 8)       | ((b & 8) << 1) |
+          (r & 1)       | ((g & 1) << 1);
+  // Lower half: planes 1-3 in bits 5-7, plane 0 G,B in the 1st byte and
+  // R in the 2nd
+  p[3] = ((p[0] & 0B00011100) << 3) | (g & 1) | ((b & 1) << 1);
+  p[4] = ((p[1] & 0B00011100) << 3) | ((r & 1) << 1);
+  p[5] =  (p[2] & 0B00011100) << 3;
+}
+
+void RGBmatrixPanel::drawIndex(int16_t x, int16_t y, uint8_t i) {
+
+  if(!indexBuf) return;
+  if((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
+
+  switch(rotation) {
+   case 1:
+    swap(x, y);
+    x = WIDTH  - 1 - x;
+    break;
+   case 2:
+    x = WIDTH  - 1 - x;
+    y = HEIGHT - 1 - y;
+    break;
+   case 3:
+    swap(x, y);
+    y = HEIGHT - 1 - y;
+    break;
+  }
+
+  indexBuf[y * WIDTH + x] = i;
+}
+
+// A whole row of indices, width() of them, as drawIndex() would write
+// them one by one.  Unrotated that is a straight copy.
+void RGBmatrixPanel::drawIndexRow(int16_t y, const uint8_t *row) {
+  uint8_t *p;
+  int16_t  x;
+
+  if(!indexBuf) return;
+  if((y < 0) || (y >= _height)) return;
+
+  switch(rotation) {
+   case 0:
+    memcpy(&indexBuf[y * WIDTH], row, WIDTH);
+    break;
+   case 1:                            // Down raw column WIDTH-1-y
+    p = &indexBuf[WIDTH - 1 - y];
+    for(x=0; x<_width; x++, p += WIDTH) *p = *row++;
+    break;
+   case 2:                            // Backwards along raw row
+    p = &indexBuf[(HEIGHT - 1 - y) * WIDTH + WIDTH - 1];
+    for(x=0; x<_width; x++) *p-- = *row++;
+    break;
+   case 3:                            // Up raw column y
+    p = &indexBuf[(HEIGHT - 1) * WIDTH + y];
+    for(x=0; x<_width; x++, p -= WIDTH) *p = *row++;
+    break;
+  }
+}
+
+// A whole row of colors, width() of them, as drawPixel() would write
+// them one by one: clipped and rotated once for the row, and each pixel
+// stored as its three plane bytes (see planeBytes()) under a mask that
+// keeps the pixel sharing them, instead of bit by bit in writePixel().
+void RGBmatrixPanel::drawRow(int16_t y, const rgb444_t *row) {
+  uint8_t  p[6], *ptr;
+  int16_t  x, rx, ry, dx, dy;
+
+  if((y < 0) || (y >= _height)) return;
+
+  switch(rotation) {
+   case 0:  rx = 0;             ry = y;              dx =  1; dy =  0; break;
+   case 1:  rx = WIDTH - 1 - y; ry = 0;              dx =  0; dy =  1; break;
+   case 2:  rx = WIDTH - 1;     ry = HEIGHT - 1 - y; dx = -1; dy =  0; break;
+   default: rx = y;             ry = HEIGHT - 1;     dx =  0; dy = -1; break;
+  }
+
+  for(x=0; x<_width; x++, rx += dx, ry += dy) {
+    planeBytes(*row++, p);
+    if(ry < nRows) {
+      ptr = &matrixbuff[backindex][ry * WIDTH * (nPlanes - 1) + rx];
+      ptr[0]       = (ptr[0]       & 0B11100011) | p[0];
+      ptr[WIDTH]   = (ptr[WIDTH]   & 0B11100010) | p[1];
+      ptr[WIDTH*2] = (ptr[WIDTH*2] & 0B11100000) | p[2];
+    } else {
+      ptr = &matrixbuff[backindex][(ry - nRows) * WIDTH * (nPlanes - 1) + rx];
+      ptr[0]       = (ptr[0]       & 0B00011100) | p[3];
+      ptr[WIDTH]   = (ptr[WIDTH]   & 0B00011101) | p[4];
+      ptr[WIDTH*2] = (ptr[WIDTH*2] & 0B00011111) | p[5];
+    }
+  }
+}
+
+// Index buffer -> back buffer bit planes.  Each byte of a plane holds one
+// upper-half and one lower-half pixel, so both are looked up together.
+void RGBmatrixPanel::resolveIndexed(void) {
+  uint8_t       *ptr   = matrixbuff[backindex],
+                *upper = indexBuf,
+                *lower = &indexBuf[nRows * WIDTH];
+  const uint8_t *u, *l;
+
+  for(uint8_t y=0; y<nRows; y++) {
+    for(int16_t x=0; x<WIDTH; x++) {
+      u = paletteBits[*upper++];
+      l = paletteBits[*lower++];
+      ptr[0]       = u[0] | l[3];
+      ptr[WIDTH]   = u[1] | l[4];
+      ptr[WIDTH*2] = u[2] | l[5];
+      ptr++;
+    }
+    ptr += WIDTH * (nPlanes - 2); // Skip the other two planes of this row
+  }
+}
+
 // For smooth animation -- drawing always takes place in the "back" buffer;
 // this method pushes it to the "front" for display.  Passing "true", the
 // updated display contents are then copied to the new back buffer and can
 // be incrementally modified.  If "false", the back buffer then contains
 // the old front buffer contents -- your code can either clear this or
 // draw over every pixel.  (No effect if double-buffering is not enabled.)
-void RGBmatrixPanel::swapBuffers(boolean copy) {
+// The back buffer is first made into the finished frame, see
+// composeFrame(); pass compose = false to show it exactly as it is
+// instead (e.g. the steps of a blend of finished frames).
+void RGBmatrixPanel::swapBuffers(boolean copy, boolean compose) {
+  if(compose) composeFrame();
   if(matrixbuff[0] != matrixbuff[1]) {
     // To avoid 'tearing' display, actual swap takes place in the interrupt
     // handler, at the end of a complete screen refresh cycle.
@@ -371,6 +903,28 @@ void RGBmatrixPanel::swapBuffers(boolean copy) {
   }
 }
 
+// Turn the back buffer into the frame swapBuffers() would show: in
+// indexed mode (see setIndexed()) the index buffer is resolved into it,
+// then any overlay layer (see setOverlay()) is merged in.  swapBuffers()
+// does this itself; call it directly to work on the finished frame, then
+// swap with compose = false.
+void RGBmatrixPanel::composeFrame(void) {
+  if(indexed) resolveIndexed();
+  if(overlay) drawCanvas(overlayX, overlayY, *overlay);
+}
+
+// Two-layer compositing: the back buffer is the background layer, which
+// animated modes redraw every frame, and 'canvas' is an overlay layer
+// (e.g. clock digits) that is merged over it, at (x,y), each time a frame
+// is presented by swapBuffers().  The overlay only needs redrawing when
+// its content changes.  Transparent overlay pixels show the background.
+// Pass NULL to remove the overlay.
+void RGBmatrixPanel::setOverlay(GFXcanvas444 *canvas, int16_t x, int16_t y) {
+  overlay  = canvas;
+  overlayX = x;
+  overlayY = y;
+}
+
 // Dump display contents to the Serial Monitor, adding some formatting to
 // simplify copy-and-paste of data as a PROGMEM-embedded image for another
 // sketch.  If using multiple dumps this way, you'll need to edit the
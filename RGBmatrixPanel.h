@@ -1,5 +1,17 @@
+#ifndef _RGBMATRIXPANEL_H
+#define _RGBMATRIXPANEL_H
+
 
 #include "Adafruit_mfGFX.h"
+#include "GFXcanvas.h"
+
+// Native matrix color: 4 bits per channel packed as 0x0RGB, the depth the
+// bit planes hold.  Convert once with RGBmatrixPanel::RGB444() when the
+// color is chosen, then draw with the rgb444_t overloads; uint16_t (5/6/5)
+// colors are converted again on every pixel written.
+struct rgb444_t {
+  uint16_t rgb;
+};
 
 class RGBmatrixPanel : public Adafruit_GFX {
 
@@ -16,18 +28,73 @@ class RGBmatrixPanel : public Adafruit_GFX {
   void
     begin(void),
     drawPixel(int16_t x, int16_t y, uint16_t c),
+    drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t c),
+    drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c),
+    drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c),
+    fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c),
     fillScreen(uint16_t c),
+    drawFastChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+      uint16_t bg, uint8_t size),
     updateDisplay(void),
-    swapBuffers(boolean),
-    dumpMatrix(void);
+    swapBuffers(boolean copy, boolean compose=true),
+    composeFrame(void),
+    dumpMatrix(void),
+    drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+      int16_t w, int16_t h, uint16_t c),
+    drawCanvas(int16_t x, int16_t y, GFXcanvas1 &canvas, uint16_t c),
+    drawCanvas(int16_t x, int16_t y, GFXcanvas444 &canvas),
+    setOverlay(GFXcanvas444 *canvas, int16_t x=0, int16_t y=0),
+    setHuePalette(uint8_t sat, uint8_t val, boolean gflag),
+    setPaletteColor(uint8_t i, uint16_t c),
+    setPaletteColor(uint8_t i, rgb444_t c),
+    drawIndex(int16_t x, int16_t y, uint8_t i),
+    drawIndexRow(int16_t y, const uint8_t *row),
+    fadeBuffer(const uint8_t *src, uint8_t level),
+    blendBuffers(const uint8_t *a, const uint8_t *b, uint8_t alpha),
+    addBuffer(const uint8_t *src);
+  boolean
+    setIndexed(boolean on);
   uint8_t
-    *backBuffer(void);
+    *backBuffer(void),
+    *frontBuffer(void),
+    *indexBuffer(void);
   uint16_t
     Color333(uint8_t r, uint8_t g, uint8_t b),
     Color444(uint8_t r, uint8_t g, uint8_t b),
     Color888(uint8_t r, uint8_t g, uint8_t b),
     Color888(uint8_t r, uint8_t g, uint8_t b, boolean gflag),
-    ColorHSV(long hue, uint8_t sat, uint8_t val, boolean gflag);
+    ColorHSV(long hue, uint8_t sat, uint8_t val, boolean gflag),
+    huePalette(long hue);
+
+  // Native 4/4/4 drawing, see rgb444_t.  The 5/6/5 calls above and in
+  // Adafruit_GFX all remain available.
+  using Adafruit_GFX::drawRect;
+  using Adafruit_GFX::drawChar;
+  void
+    drawPixel(int16_t x, int16_t y, rgb444_t c),
+    drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, rgb444_t c),
+    drawFastVLine(int16_t x, int16_t y, int16_t h, rgb444_t c),
+    drawFastHLine(int16_t x, int16_t y, int16_t w, rgb444_t c),
+    drawRect(int16_t x, int16_t y, int16_t w, int16_t h, rgb444_t c),
+    fillRect(int16_t x, int16_t y, int16_t w, int16_t h, rgb444_t c),
+    fillScreen(rgb444_t c),
+    drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+      int16_t w, int16_t h, rgb444_t c),
+    drawChar(int16_t x, int16_t y, unsigned char c, rgb444_t color,
+      rgb444_t bg, uint8_t size),
+    drawRow(int16_t y, const rgb444_t *row);
+
+  // 4-bit components to native color
+  static rgb444_t RGB444(uint8_t r, uint8_t g, uint8_t b) {
+    rgb444_t c = { (uint16_t)(((r & 0xF) << 8) | ((g & 0xF) << 4) | (b & 0xF)) };
+    return c;
+  }
+  // Adafruit_GFX 5/6/5 to native color, truncating like drawPixel() does
+  static rgb444_t RGB444(uint16_t c) {
+    rgb444_t n = { (uint16_t)(((c >> 4) & 0xF00) | ((c >> 3) & 0x0F0) |
+                              ((c >> 1) & 0x00F)) };
+    return n;
+  }
 
  private:
 
@@ -36,6 +103,27 @@ class RGBmatrixPanel : public Adafruit_GFX {
   volatile uint8_t backindex;
   volatile boolean swapflag;
 
+  // Overlay layer merged over the back buffer by swapBuffers():
+  GFXcanvas444    *overlay;
+  int16_t          overlayX, overlayY;
+
+  // ColorHSV() results for all 1536 hues, see setHuePalette():
+  uint16_t        *hueTable;
+  uint8_t          hueSat, hueVal;
+  boolean          hueGamma;
+
+  // Palette-indexed back buffer, see setIndexed().  paletteBits holds
+  // each palette color pre-split into the 3 packed plane bytes, for an
+  // upper-half pixel ([0..2]) and a lower-half pixel ([3..5]).
+  uint8_t         *indexBuf;
+  uint8_t        (*paletteBits)[6];
+  boolean          indexed;
+  void resolveIndexed(void);
+  static void planeBytes(rgb444_t c, uint8_t *p);
+
+  // Store a 4/4/4 pixel at raw, already-clipped coordinates:
+  void writePixel(int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);
+
   // Init/alloc code common to both constructors:
   void init(uint8_t rows, uint8_t a, uint8_t b, uint8_t c,
     uint8_t sclk, uint8_t latch, uint8_t oe, boolean dbuf,
@@ -49,3 +137,5 @@ class RGBmatrixPanel : public Adafruit_GFX {
   volatile uint8_t row, plane;
   volatile uint8_t *buffptr;
 };
+
+#endif // _RGBMATRIXPANEL_H
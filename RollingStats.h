@@ -0,0 +1,86 @@
+#ifndef _ROLLINGSTATS_H
+#define _ROLLINGSTATS_H
+
+#include "application.h"
+
+// Minimum, maximum and average of the last N values pushed, each in
+// constant time however long the window is.  The values sit in a ring
+// buffer with a running sum; the minimum and maximum come from two
+// monotonic queues that only hold values which can still become the
+// extreme of the window (anything older and smaller than a newer value
+// can never be the maximum again, so it is dropped on push).
+//
+// T is a signed or unsigned integer type, N at most 128.  Memory is
+// about 3 * N values plus a few bytes.
+
+template<class T, uint8_t N> class RollingStats {
+
+ public:
+
+  RollingStats(void) { reset(); }
+
+  void reset(void) {
+    count = slot = next = 0;
+    sum   = 0;
+    lows.clear();
+    highs.clear();
+  }
+
+  void push(T v) {
+    if(count == N) sum -= values[slot];      // Oldest leaves the window
+    else           count++;
+    values[slot] = v;
+    if(++slot == N) slot = 0;
+    sum += v;
+    lows.push(v, next, true);
+    highs.push(v, next, false);
+    next++;                                  // Wraps; only ages < N matter
+  }
+
+  // All 0 until something is pushed
+  T lowest(void)  const { return count ? lows.front()  : 0; }
+  T highest(void) const { return count ? highs.front() : 0; }
+  T average(void) const { return count ? sum / count   : 0; }
+  int32_t total(void) const { return sum; }
+  uint8_t size(void)  const { return count; }   // N once the window is full
+
+ private:
+
+  // Values in push order with the sequence number each was pushed at.
+  // Front is the window's extreme; values only ever get less extreme
+  // towards the back.
+  struct Queue {
+    T       value[N];
+    uint8_t seq[N], head, length;
+
+    void clear(void) { head = length = 0; }
+    T front(void) const { return value[head]; }
+    void push(T v, uint8_t now, boolean lowest) {
+      uint8_t back;
+      // Drop the front if it has slid out of the window...
+      if(length && ((uint8_t)(now - seq[head]) >= N)) {
+        head = (head + 1) % N;
+        length--;
+      }
+      // ...and from the back everything v beats
+      while(length) {
+        back = (head + length - 1) % N;
+        if(lowest ? (value[back] < v) : (value[back] > v)) break;
+        length--;
+      }
+      back        = (head + length) % N;
+      value[back] = v;
+      seq[back]   = now;
+      length++;
+    }
+  };
+
+  T       values[N];
+  int32_t sum;
+  uint8_t count, slot, next;                 // next = sequence number
+  Queue   lows, highs;
+
+  static_assert(N >= 1 && N <= 128, "window is 1 to 128 values");
+};
+
+#endif // _ROLLINGSTATS_H
@@ -29,10 +29,20 @@
 */
 
 #include "fix_fft.h"
+#include "fixmath.h"
 
 #define N_WAVE      256    /* full length of Sinewave[] */
 #define LOG2_N_WAVE 8      /* log2(N_WAVE) */
 
+#define LOG2_N_MAX16 10    /* 16-bit transforms: up to 1024 points */
+
+/*
+ Largest component a 16-bit butterfly can take without
+ overflowing: |q + w*z| <= |q| + sqrt(2)*max(|zr|,|zi|), so
+ 32767 / (1 + sqrt(2)).
+*/
+#define BFP_LIMIT   13572
+
 
 /*
  Since we only use 3/4 of N_WAVE, we define only
@@ -98,28 +108,36 @@ inline int8_t FIX_MPY(int8_t a, int8_t b)
    return a;
 }
 
-/*
- fix_fft() - perform forward/inverse fast Fourier transform.
- fr[n],fi[n] are real and imaginary arrays, both INPUT AND
- RESULT (in-place FFT), with 0 <= n < 2**m; set inverse to
- 0 for forward transform (FFT), or 1 for iFFT.
-*/
-int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
+/* Q15 version, for the 16-bit transforms */
+inline int16_t FIX_MPY(int16_t a, int16_t b)
 {
-   int16_t mr, nn, i, j, l, k, istep, n, scale, shift;
-   int8_t qr, qi, tr, ti, wr, wi;
+   /* shift right one less bit (i.e. 15-1) */
+   int32_t c = ((int32_t)a * (int32_t)b) >> 14;
+   /* last bit shifted out = rounding-bit */
+   b = c & 0x01;
+   /* last shift + rounding bit */
+   a = (c >> 1) + b;
 
-   n = 1 << m;
+   return a;
+}
 
-   /* max FFT size = N_WAVE */
-   if (n > N_WAVE)
-       return -1;
+/*
+ bit_reverse() - decimation in time, re-order f[0..n-1] by
+ bit-reversed index.  Applied to fr[] and fi[] in turn this is
+ the usual first pass of a complex FFT; applied to a whole
+ array of 2n real samples it also moves the even samples to
+ the lower half and the odd ones to the upper half, which is
+ the fr[], fi[] split fix_fftr() needs.
+*/
+template <typename T>
+static void bit_reverse(T f[], int16_t n)
+{
+   int16_t m, mr, nn, l;
+   T t;
 
    mr = 0;
    nn = n - 1;
-   scale = 0;
 
-   /* decimation in time - re-order data */
    for (m=1; m<=nn; ++m) {
        l = n;
        do {
@@ -129,13 +147,23 @@ int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
 
        if (mr <= m)
            continue;
-       tr = fr[m];
-       fr[m] = fr[mr];
-       fr[mr] = tr;
-       ti = fi[m];
-       fi[m] = fi[mr];
-       fi[mr] = ti;
+       t = f[m];
+       f[m] = f[mr];
+       f[mr] = t;
    }
+}
+
+/*
+ fft8() - butterfly passes of the 8-bit fix_fft(), on data
+ already in bit-reversed order.
+*/
+static int16_t fft8(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
+{
+   int16_t i, j, l, k, istep, n, scale, shift;
+   int8_t qr, qi, tr, ti, wr, wi;
+
+   n = 1 << m;
+   scale = 0;
 
    l = 1;
    k = LOG2_N_WAVE-1;
@@ -206,32 +234,249 @@ int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
 }
 
 /*
- fix_fftr() - forward/inverse FFT on array of real numbers.
- Real FFT/iFFT using half-size complex FFT by distributing
- even/odd samples into real/imaginary arrays respectively.
- In order to save data space (i.e. to avoid two arrays, one
- for real, one for imaginary samples), we proceed in the
- following two steps: a) samples are rearranged in the real
- array so that all even samples are in places 0-(N/2-1) and
- all imaginary samples in places (N/2)-(N-1), and b) fix_fft
- is called with fr and fi pointing to index 0 and index N/2
- respectively in the original array. The above guarantees
- that fix_fft "sees" consecutive real samples as alternating
- real and imaginary samples in the complex array.
+ fft16() - butterfly passes of the 16-bit fix_fft(), on data
+ already in bit-reversed order.  Block floating point: before
+ each pass the whole block is halved (or quartered) only if
+ its largest component could overflow in that pass, and the
+ number of halvings is returned.  Twiddles are Q15 from
+ fix_sin()/fix_cos().
 */
-int16_t fix_fftr(int8_t f[], int16_t m, int16_t inverse)
+static int16_t fft16(int16_t fr[], int16_t fi[], int16_t m, int16_t inverse)
 {
-   int16_t i, N = 1<<(m-1), scale = 0;
-   int8_t tt, *fr=f, *fi=&f[N];
-
-   if (inverse)
-       scale = fix_fft(fi, fr, m-1, inverse);
-   for (i=1; i<N; i+=2) {
-       tt = f[N+i-1];
-       f[N+i-1] = f[i];
-       f[i] = tt;
+   int16_t i, j, l, k, istep, n, scale, shift;
+   int16_t qr, qi, tr, ti, wr, wi;
+   int32_t peak;
+   uint16_t angle;
+
+   n = 1 << m;
+   scale = 0;
+
+   l = 1;
+   k = 15;                       /* angle of pi / l is 1 << k */
+   while (l < n) {
+       peak = 0;
+       for (i=0; i<n; ++i) {
+           if (fr[i] > peak)  peak = fr[i];
+           if (-fr[i] > peak) peak = -fr[i];
+           if (fi[i] > peak)  peak = fi[i];
+           if (-fi[i] > peak) peak = -fi[i];
+       }
+       if (peak > 2 * BFP_LIMIT)
+           shift = 2;
+       else if (peak > BFP_LIMIT)
+           shift = 1;
+       else
+           shift = 0;
+       scale += shift;
+
+       istep = l << 1;
+       for (m=0; m<l; ++m) {
+           angle = (uint16_t)m << k;
+           wr =  fix_cos(angle);
+           wi = -fix_sin(angle);
+           if (inverse)
+               wi = -wi;
+           wr >>= shift;
+           wi >>= shift;
+           for (i=m; i<n; i+=istep) {
+               j = i + l;
+               tr = FIX_MPY(wr,fr[j]) - FIX_MPY(wi,fi[j]);
+               ti = FIX_MPY(wr,fi[j]) + FIX_MPY(wi,fr[j]);
+               qr = fr[i] >> shift;
+               qi = fi[i] >> shift;
+               fr[j] = qr - tr;
+               fi[j] = qi - ti;
+               fr[i] = qr + tr;
+               fi[i] = qi + ti;
+           }
+       }
+       --k;
+       l = istep;
    }
-   if (! inverse)
-       scale = fix_fft(fi, fr, m-1, inverse);
    return scale;
-}
\ No newline at end of file
+}
+
+/*
+ fix_fft() - perform forward/inverse fast Fourier transform.
+ fr[n],fi[n] are real and imaginary arrays, both INPUT AND
+ RESULT (in-place FFT), with 0 <= n < 2**m; set inverse to
+ 0 for forward transform (FFT), or 1 for iFFT.
+*/
+int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
+{
+   int16_t n = 1 << m;
+
+   /* max FFT size = N_WAVE */
+   if (n > N_WAVE)
+       return -1;
+
+   bit_reverse(fr, n);
+   bit_reverse(fi, n);
+   return fft8(fr, fi, m, inverse);
+}
+
+int16_t fix_fft(int16_t fr[], int16_t fi[], int16_t m, int16_t inverse)
+{
+   int16_t n = 1 << m;
+
+   if (m > LOG2_N_MAX16)
+       return -1;
+
+   bit_reverse(fr, n);
+   bit_reverse(fi, n);
+   return fft16(fr, fi, m, inverse);
+}
+
+/*
+ fix_fftr() - forward FFT on an array of N = 2**m real numbers.
+ The samples are treated as N/2 complex values z[n] = f[2n] +
+ j*f[2n+1]: an N point bit reversal leaves the evens, in the
+ bit-reversed order a complex FFT wants, in f[0..N/2-1] and the
+ odds in f[N/2..N-1], and the butterfly passes then run at half
+ the size.  A split step separates the spectra of the even and
+ odd samples, Fe and Fo, and combines them into the first half
+ of the real spectrum:
+
+   X[k]       = Fe[k] + W^k Fo[k]
+   X[N/2 - k] = conj(Fe[k] - W^k Fo[k]),   W = exp(-2*pi*j/N)
+
+ with Fe[k] = (Z[k] + conj Z[N/2-k]) / 2 and
+      Fo[k] = (Z[k] - conj Z[N/2-k]) / 2j.
+
+ Output, in place: f[k] = Re X[k], f[N/2+k] = Im X[k] for
+ k = 1 .. N/2-1; f[0] = X[0] and f[N/2] = X[N/2], both real.
+ The 8-bit version is scaled like fix_fft() (by 1/N), so
+ magnitudes match a complex fix_fft() of the same samples with
+ fi[] zeroed, and returns 0.  The 16-bit version returns the
+ block exponent: X[k] = f[...] << return value.  The inverse
+ transform is not supported (returns -1).
+*/
+int16_t fix_fftr(int8_t f[], int16_t m, int16_t inverse)
+{
+   int16_t i, k, h = 1 << (m-1), fe_r, fe_i, fo_r, fo_i, t_r, t_i;
+   int8_t *zr = f, *zi = &f[h], wr, wi;
+
+   if (inverse || m < 2 || (1 << m) > N_WAVE)
+       return -1;
+
+   bit_reverse(f, 2 * h);
+   fft8(zr, zi, m-1, 0);       /* Z[k] / (N/2) */
+
+   /* DC and Nyquist are real */
+   t_r = zr[0];
+   t_i = zi[0];
+   zr[0] = (t_r + t_i) >> 1;
+   zi[0] = (t_r - t_i) >> 1;
+
+   /*
+     k and N/2-k are computed together from Z[k] and Z[N/2-k];
+     sums below are doubled (2Fe, 2Fo, 2W^kFo) and the
+     /2 for the 1/N scaling makes a final >> 2.
+   */
+   for (k=1; k<=h/2; ++k) {
+       i = h - k;
+       fe_r = zr[k] + zr[i];
+       fe_i = zi[k] - zi[i];
+       fo_r = zi[k] + zi[i];
+       fo_i = zr[i] - zr[k];
+       /* W^k = cos - j sin, for angle 2*pi*k/N */
+       wr = (int8_t)pgm_read_byte_near(Sinewave + (k << (LOG2_N_WAVE-m)) + N_WAVE/4);
+       wi = (int8_t)pgm_read_byte_near(Sinewave + (k << (LOG2_N_WAVE-m)));
+       t_r = ((int16_t)wr * fo_r + (int16_t)wi * fo_i) >> 7;
+       t_i = ((int16_t)wr * fo_i - (int16_t)wi * fo_r) >> 7;
+       zr[k] = (fe_r + t_r) >> 2;
+       zi[k] = (fe_i + t_i) >> 2;
+       zr[i] = (fe_r - t_r) >> 2;
+       zi[i] = (t_i - fe_i) >> 2;
+   }
+   return 0;
+}
+
+int16_t fix_fftr(int16_t f[], int16_t m, int16_t inverse)
+{
+   int16_t i, k, h = 1 << (m-1), scale, wr, wi, *zr = f, *zi = &f[h];
+   int32_t fe_r, fe_i, fo_r, fo_i, t_r, t_i, peak;
+   uint16_t angle;
+
+   if (inverse || m < 2 || m > LOG2_N_MAX16)
+       return -1;
+
+   bit_reverse(f, 2 * h);
+   scale = fft16(zr, zi, m-1, 0);  /* Z[k] >> scale */
+
+   /*
+     |X[k]| <= 2 |Z|max, so X/2 fits as long as no component of
+     Z exceeds 32767 / sqrt(2); halve the block first if one does.
+   */
+   peak = 0;
+   for (i=0; i<2*h; ++i) {
+       if (f[i] > peak)  peak = f[i];
+       if (-f[i] > peak) peak = -f[i];
+   }
+   if (peak > 23170) {
+       for (i=0; i<2*h; ++i)
+           f[i] >>= 1;
+       ++scale;
+   }
+
+   /* DC and Nyquist are real */
+   t_r = zr[0];
+   t_i = zi[0];
+   zr[0] = (t_r + t_i) >> 1;
+   zi[0] = (t_r - t_i) >> 1;
+
+   /* as above; doubled sums, and >> 2 leaves X/2 */
+   for (k=1; k<=h/2; ++k) {
+       i = h - k;
+       fe_r = (int32_t)zr[k] + zr[i];
+       fe_i = (int32_t)zi[k] - zi[i];
+       fo_r = (int32_t)zi[k] + zi[i];
+       fo_i = (int32_t)zr[i] - zr[k];
+       /* W^k = cos - j sin, for angle 2*pi*k/N */
+       angle = (uint16_t)k << (16-m);
+       wr = fix_cos(angle);
+       wi = fix_sin(angle);
+       t_r = ((wr * fo_r) >> 15) + ((wi * fo_i) >> 15);
+       t_i = ((wr * fo_i) >> 15) - ((wi * fo_r) >> 15);
+       zr[k] = (fe_r + t_r) >> 2;
+       zi[k] = (fe_i + t_i) >> 2;
+       zr[i] = (fe_r - t_r) >> 2;
+       zi[i] = (t_i - fe_i) >> 2;
+   }
+   return scale + 1;
+}
+
+void fix_goertzel_init(goertzel_t *g, uint16_t freq, uint16_t rate)
+{
+   uint16_t angle = ((uint32_t)freq << 16) / rate;   /* 65536 = 2 pi */
+
+   g->cosw = fix_cos(angle);
+   g->sinw = fix_sin(angle);
+   g->s1 = g->s2 = 0;
+}
+
+void fix_goertzel(goertzel_t g[], uint8_t n, int16_t x)
+{
+   int32_t s;
+
+   /* s[n] = x + 2 cos(w) s[n-1] - s[n-2]; cosw in Q15 is 2 cos(w) in Q14 */
+   for (; n; --n, ++g) {
+       s = x + (int32_t)(((int64_t)g->cosw * g->s1) >> 14) - g->s2;
+       g->s2 = g->s1;
+       g->s1 = s;
+   }
+}
+
+uint16_t fix_goertzel_mag(goertzel_t *g, int16_t m)
+{
+   int32_t re, im;
+
+   /* X = s[n-1] - s[n-2] e^-jw, up to a phase factor */
+   re = (g->s1 - (int32_t)(((int64_t)g->cosw * g->s2) >> 15)) >> m;
+   im = (int32_t)(((int64_t)g->sinw * g->s2) >> 15) >> m;
+   g->s1 = g->s2 = 0;
+
+   if (re > 32767) re = 32767; else if (re < -32767) re = -32767;
+   if (im > 32767) im = 32767; else if (im < -32767) im = -32767;
+   return fix_hypot(re, im);
+}
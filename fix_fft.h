@@ -18,22 +18,54 @@
 */
 int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse);
 
+/*
+ 16-bit (Q15) fix_fft(), same calling convention, for 2**m up
+ to 1024 points.  Block floating point in both directions: a
+ pass only halves the data if it could otherwise overflow, so
+ quiet input keeps its precision.  Returns the number of
+ halvings: the unnormalized transform is fr[], fi[] shifted
+ left by the return value (shift right by m less to get the
+ 1/n scaling of the 8-bit forward transform).  Returns -1 if
+ m is too large.
+*/
+int16_t fix_fft(int16_t fr[], int16_t fi[], int16_t m, int16_t inverse);
+
 
 /*
- fix_fftr() - forward/inverse FFT on array of real numbers.
- Real FFT/iFFT using half-size complex FFT by distributing
- even/odd samples into real/imaginary arrays respectively.
- In order to save data space (i.e. to avoid two arrays, one
- for real, one for imaginary samples), we proceed in the
- following two steps: a) samples are rearranged in the real
- array so that all even samples are in places 0-(N/2-1) and
- all imaginary samples in places (N/2)-(N-1), and b) fix_fft
- is called with fr and fi pointing to index 0 and index N/2
- respectively in the original array. The above guarantees
- that fix_fft "sees" consecutive real samples as alternating
- real and imaginary samples in the complex array.
+ fix_fftr() - forward FFT on array of N = 2**m real numbers,
+ using a half-size complex FFT plus a split step, in place.
+ Scaled like fix_fft(); on return f[0] = X[0], f[N/2] = X[N/2]
+ (both real) and f[k], f[N/2+k] = Re, Im of X[k] for
+ 0 < k < N/2.  The 16-bit version returns the block exponent
+ as fix_fft() does.  Forward only: returns -1 if inverse is
+ set.
 */
 int16_t fix_fftr(int8_t f[], int16_t m, int16_t inverse);
+int16_t fix_fftr(int16_t f[], int16_t m, int16_t inverse);
+
+
+/*
+ Goertzel filters - the spectrum at a few chosen frequencies,
+ one sample at a time.  Each filter costs one multiply per
+ sample, so for a handful of bands this is much cheaper than a
+ transform, and the frequencies need not be bins of one.
+
+ fix_goertzel_init() sets a filter to 'freq' Hz at 'rate'
+ samples per second.  fix_goertzel() feeds sample x (up to 12
+ bits plus sign, e.g. an ADC reading less its midpoint) to
+ 'n' filters.  After 2**m samples, fix_goertzel_mag() gives a
+ filter's magnitude, scaled like the 16-bit fix_fft() output
+ once unscaled by m (a sine of amplitude A reads A/2), and
+ resets it for the next block.
+*/
+typedef struct {
+	int16_t cosw, sinw;		// cos, sin of 2 pi freq / rate, Q15
+	int32_t s1, s2;			// Last two filter outputs
+} goertzel_t;
+
+void fix_goertzel_init(goertzel_t *g, uint16_t freq, uint16_t rate);
+void fix_goertzel(goertzel_t g[], uint8_t n, int16_t x);
+uint16_t fix_goertzel_mag(goertzel_t *g, int16_t m);
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+/*
+ Fixed-point sin/cos and integer square root, see fixmath.h.
+*/
+
+#include "fixmath.h"
+
+/*
+ sin(i * pi / 128) for the first quarter turn, in Q15.  The extra 65th
+ entry saves a special case when interpolating up to pi / 2.
+*/
+static const int16_t quarterSine[65] = {
+    0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+ 6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+32767
+};
+
+int16_t fix_sin(uint16_t angle)
+{
+	uint16_t a = angle & 0x3FFF;		// Position within the quadrant
+	uint8_t  i, frac;
+	int16_t  s;
+
+	if (angle & 0x4000)					// 2nd and 4th quadrants run backwards
+		a = 0x4000 - a;
+	i    = a >> 8;
+	frac = a & 0xFF;
+	if (i == 64)
+		s = quarterSine[64];
+	else
+		s = quarterSine[i] +
+		    (((int32_t)(quarterSine[i + 1] - quarterSine[i]) * frac) >> 8);
+
+	return (angle & 0x8000) ? -s : s;	// Lower half is negative
+}
+
+int16_t fix_cos(uint16_t angle)
+{
+	return fix_sin(angle + 0x4000);
+}
+
+uint16_t fix_isqrt(uint32_t x)
+{
+	uint32_t root = 0, bit = 1UL << 30;
+
+	while (bit > x)
+		bit >>= 2;
+	while (bit) {
+		if (x >= root + bit) {
+			x   -= root + bit;
+			root = (root >> 1) + bit;
+		}
+		else
+			root >>= 1;
+		bit >>= 2;
+	}
+	return root;
+}
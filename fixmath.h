@@ -0,0 +1,114 @@
+#ifndef FIXMATH_H
+#define FIXMATH_H
+
+#include "application.h"
+
+/*
+ Fixed-point helpers for the display modes.  Neither the Core nor the
+ Photon has an FPU, so every float add, multiply or sin() in a frame
+ loop is a soft-float library call.
+
+ q8_8   - signed 8.8, for small screen-space quantities (ball position
+          and velocity).  Range -128 .. +127.996.
+ q16_16 - signed 16.16, for anything that needs more headroom.
+
+ Angles are uint16_t phases: 65536 = one full turn, so they wrap for
+ free.  fix_sin()/fix_cos() return Q15 (-32767 .. +32767 = -1.0 .. +1.0).
+*/
+
+typedef int16_t q8_8;
+typedef int32_t q16_16;
+
+// Constant conversions - only use these with literals so the compiler
+// folds them; no float math is left in the generated code.  FIXANGLE()
+// is for signed angle steps (e.g. -0.07 rad per frame): add the result
+// to a uint16_t angle and it wraps the right way round.
+#define FIX8(f)		((q8_8)((f) * 256.0 + ((f) < 0 ? -0.5 : 0.5)))
+#define FIX16(f)	((q16_16)((f) * 65536.0 + ((f) < 0 ? -0.5 : 0.5)))
+#define FIXANGLE(rad)	((int16_t)((rad) * 10430.378 + ((rad) < 0 ? -0.5 : 0.5)))
+
+#define INT_TO_FIX8(i)	((q8_8)((i) << 8))
+#define INT_TO_FIX16(i)	((q16_16)((int32_t)(i) << 16))
+
+// Integer part, truncated toward zero like a (int) cast of a float
+#define FIX8_TO_INT(a)	((a) < 0 ? -((-(a)) >> 8) : ((a) >> 8))
+#define FIX16_TO_INT(a)	((a) < 0 ? -((-(a)) >> 16) : ((a) >> 16))
+// Nearest integer (halves away from zero) - (int)(a + 0.5) for a >= 0
+#define FIX8_ROUND(a)	FIX8_TO_INT((a) + ((a) < 0 ? -128 : 128))
+
+static inline q8_8 fix8_mul(q8_8 a, q8_8 b) {
+	return (q8_8)(((int32_t)a * b) >> 8);
+}
+
+static inline q16_16 fix16_mul(q16_16 a, q16_16 b) {
+	return (q16_16)(((int64_t)a * b) >> 16);
+}
+
+// Scale a 16.16 value by a Q15 fraction (e.g. radius * fix_cos(angle))
+static inline q16_16 fix16_mul_q15(q16_16 a, int16_t q15) {
+	return (q16_16)(((int64_t)a * q15) >> 15);
+}
+
+/*
+ fix_sin(), fix_cos() - 64 entry quarter wave table with linear
+ interpolation; at most FIX_SIN_MAX_ERROR LSB of Q15 from 32767 * sin()
+ at any angle (3.65 measured, tools/fixmathtest.cpp checks it).
+*/
+#define FIX_SIN_MAX_ERROR	4
+int16_t fix_sin(uint16_t angle);
+int16_t fix_cos(uint16_t angle);
+
+/*
+ fix_isqrt() - floor(sqrt(x)), bit by bit.  Matches a (int) cast of
+ sqrt() for every 32 bit input.
+*/
+uint16_t fix_isqrt(uint32_t x);
+
+/*
+ fix_hypot() - sqrt(x*x + y*y) without the square root, by
+ alpha max plus beta min: the larger of max + 5/32 min and
+ 27/32 max + 71/128 min.  Within 1.3% of the exact value
+ (plus up to a couple of units of truncation for small
+ inputs), cheap enough to run on every bin of an FFT.
+*/
+static inline uint16_t fix_hypot(int16_t x, int16_t y) {
+	uint16_t ax = x < 0 ? -(int32_t)x : x, ay = y < 0 ? -(int32_t)y : y,
+	         mx = ax > ay ? ax : ay, mn = ax > ay ? ay : ax;
+	uint32_t a = mx + ((uint32_t)mn * 5 >> 5),
+	         b = ((uint32_t)mx * 27 >> 5) + ((uint32_t)mn * 71 >> 7);
+	return a > b ? a : b;
+}
+
+
+/*
+ FIXMATH_STRICT - define (e.g. -DFIXMATH_STRICT) to make these GCC
+ warnings errors in code between FIXMATH_HOT_BEGIN and FIXMATH_HOT_END:
+
+   -Wdouble-promotion  a float implicitly widened to double
+   -Wfloat-conversion  a float or double implicitly stored in an integer
+                       or a narrower float
+   -Wfloat-equal       a float or double compared with == or !=
+
+ That is all it enforces.  It does not catch float or double
+ variables, float arithmetic, explicit casts, or calls to sin(),
+ cos(), sqrt() and the rest of libm (only their arguments and results
+ if they convert implicitly), so a hot region can still pull in soft
+ float.  (#pragma GCC poison would ban the keywords, but it can't be
+ lifted again at FIXMATH_HOT_END, and the sketch uses float after its
+ hot regions.)  What the fixed-point code computes is checked instead
+ by tools/fixmathtest.cpp, against the float code it replaced.
+*/
+#if defined FIXMATH_STRICT
+#define FIXMATH_HOT_BEGIN \
+	_Pragma("GCC diagnostic push") \
+	_Pragma("GCC diagnostic error \"-Wdouble-promotion\"") \
+	_Pragma("GCC diagnostic error \"-Wfloat-conversion\"") \
+	_Pragma("GCC diagnostic error \"-Wfloat-equal\"")
+#define FIXMATH_HOT_END \
+	_Pragma("GCC diagnostic pop")
+#else
+#define FIXMATH_HOT_BEGIN
+#define FIXMATH_HOT_END
+#endif
+
+#endif
@@ -1,45 +0,0 @@
-// Kunal Doshi
-// www.kunaldoshi.com
-#include "application.h"
-#define PROGMEM
-
-const unsigned char PROGMEM font3x5[38][5] = { 
-{0,0,0,0,0},		
-{0x7,0x5,0x7,0x5,0x5},  //A
-{0x7,0x5,0x7,0x5,0x7},
-{0x7,0x4,0x4,0x4,0x7},
-{0x7,0x5,0x5,0x5,0x7}, //D
-{0x7,0x4,0x7,0x4,0x7},
-{0x7,0x4,0x6,0x4,0x4},
-{0x7,0x4,0x5,0x5,0x7},
-{0x5,0x5,0x7,0x5,0x5},
-{0x7,0x2,0x2,0x2,0x7}, // I
-{0x1,0x1,0x5,0x5,0x7},
-{0x5,0x6,0x4,0x6,0x5},
-{0x4,0x4,0x4,0x4,0x7},
-{0x5,0x7,0x7,0x5,0x5}, //M
-{0x7,0x5,0x5,0x5,0x5},
-{0x2,0x5,0x5,0x5,0x2},
-{0x7,0x5,0x7,0x4,0x4}, // P
-{0x7,0x5,0x5,0x6,0x3},
-{0x7,0x5,0x7,0x6,0x5},
-{0x7,0x4,0x7,0x1,0x7}, // S
-{0x7,0x2,0x2,0x2,0x2},
-{0x5,0x5,0x5,0x5,0x7},
-{0x5,0x5,0x5,0x5,0x2}, //V
-{0x5,0x5,0x5,0x7,0x5},
-{0x5,0x5,0x2,0x5,0x5},
-{0x5,0x5,0x2,0x2,0x2},
-{0x7,0x1,0x2,0x4,0x7}, //Z
-{0x7,0x5,0x5,0x5,0x7}, // 0
-{0x2,0x6,0x2,0x2,0x7},  // 1
-{0x7,0x1,0x7,0x4,0x7},  // 2
-{0x7,0x1,0x7,0x1,0x7},
-{0x5,0x5,0x7,0x1,0x1},
-{0x7,0x4,0x7,0x1,0x7},
-{0x7,0x4,0x7,0x5,0x7},  // 6
-{0x7,0x1,0x1,0x1,0x1},
-{0x7,0x5,0x7,0x5,0x7},
-{0x7,0x5,0x7,0x1,0x1},
-{0x1,0x0,0x2,0x0,0x4}
-};
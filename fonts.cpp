@@ -12,206 +12,208 @@ Please read README.pdf for details
 
 
 #ifdef TIMESNEWROMAN8
-// Character bitmaps for timesNewRoman 8pt
+// Character bitmaps for timesNewRoman 8pt, FONT_RLE packing
 const uint8_t timesNewRoman_8ptBitmaps[] = 
 {
 	0x20, 0x7F,		// Start Character, End Character
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x80, 0x00, 0x00, 0x00, 
-	0x00, 0xA0, 0xA0, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x24, 0x24, 0x48, 0xFC, 0x48, 0xFC, 0x90, 0x90, 0x00, 0x00, 0x00, 
-	0x20, 0x70, 0xA8, 0xA0, 0x60, 0x30, 0x28, 0xA8, 0x70, 0x20, 0x00, 0x00, 
-	0x00, 0x00, 0x41, 0x00, 0xA2, 0x00, 0xA4, 0x00, 0x48, 0x00, 0x09, 0x00, 0x12, 0x80, 0x22, 0x80, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0xF0, 0x90, 
+	0x7E, 0x80, 
+	0x16, 0xD0, 0x00, 0x00, 0x00, 
+	0x00, 0x92, 0x52, 0xFD, 0x2F, 0xE4, 0x90, 0x00, 0x00, 
+	0x23, 0xAB, 0x46, 0x18, 0xB5, 0x71, 0x00, 0x00, 
+	0x00, 0x20, 0xA8, 0x94, 0x84, 0x80, 0x48, 0x4A, 0x45, 0x41, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x1C, 0x24, 0x28, 0x33, 0xD2, 0x94, 0x89, 0x76, 0x00, 0x00, 0x00, 
-	0x00, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x20, 0x40, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x20, 0x00, 
-	0x00, 0x80, 0x40, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x40, 0x80, 0x00, 
-	0x00, 0x20, 0xA8, 0x70, 0xA8, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x20, 0x20, 0xF8, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x40, 0x80, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 
-	0x00, 0x20, 0x20, 0x40, 0x40, 0x40, 0x40, 0x80, 0x80, 0x00, 0x00, 0x00, 
-	0x00, 0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00, 0x00, 0x00, 
-	0x00, 0xC0, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x00, 0x00, 0x00, 
-	0x00, 0x70, 0x88, 0x08, 0x08, 0x10, 0x20, 0x48, 0xF8, 0x00, 0x00, 0x00, 
-	0x00, 0x70, 0x88, 0x08, 0x30, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0x00, 
-	0x00, 0x10, 0x30, 0x50, 0x50, 0x90, 0xF8, 0x10, 0x10, 0x00, 0x00, 0x00, 
-	0x00, 0x38, 0x40, 0x60, 0x10, 0x08, 0x08, 0x08, 0xF0, 0x00, 0x00, 0x00, 
-	0x00, 0x18, 0x60, 0x40, 0xB0, 0xC8, 0x88, 0x88, 0x70, 0x00, 0x00, 0x00, 
-	0x00, 0x78, 0x88, 0x08, 0x10, 0x10, 0x10, 0x20, 0x20, 0x00, 0x00, 0x00, 
-	0x00, 0x70, 0x88, 0x88, 0x70, 0x50, 0x88, 0x88, 0x70, 0x00, 0x00, 0x00, 
-	0x00, 0x70, 0x88, 0x88, 0x88, 0x78, 0x10, 0x30, 0xC0, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0xC0, 0x40, 0x80, 0x00, 
-	0x00, 0x00, 0x00, 0x08, 0x70, 0x80, 0x70, 0x08, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x80, 0x70, 0x08, 0x70, 0x80, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x60, 0x90, 0x10, 0x20, 0x40, 0x40, 0x00, 0x40, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x1E, 0x00, 0x21, 0x00, 0x4E, 0x80, 0x92, 0x80, 0xA4, 0x80, 0xA4, 0x80, 0xA7, 0x00, 0x98, 0x00, 0x40, 0x80, 0x21, 0x00, 0x1E, 0x00, 
-	0x00, 0x10, 0x10, 0x28, 0x28, 0x28, 0x7C, 0x44, 0xEE, 0x00, 0x00, 0x00, 
-	0x00, 0xF8, 0x44, 0x44, 0x78, 0x44, 0x44, 0x44, 0xF8, 0x00, 0x00, 0x00, 
-	0x00, 0x3C, 0x44, 0x80, 0x80, 0x80, 0x80, 0x44, 0x38, 0x00, 0x00, 0x00, 
-	0x00, 0xF8, 0x44, 0x42, 0x42, 0x42, 0x42, 0x44, 0xF8, 0x00, 0x00, 0x00, 
-	0x00, 0xFC, 0x44, 0x50, 0x70, 0x50, 0x40, 0x44, 0xFC, 0x00, 0x00, 0x00, 
-	0x00, 0xFC, 0x44, 0x50, 0x70, 0x50, 0x40, 0x40, 0xE0, 0x00, 0x00, 0x00, 
-	0x00, 0x3C, 0x44, 0x80, 0x80, 0x8E, 0x84, 0x44, 0x38, 0x00, 0x00, 0x00, 
-	0x00, 0xEE, 0x44, 0x44, 0x7C, 0x44, 0x44, 0x44, 0xEE, 0x00, 0x00, 0x00, 
-	0x00, 0xE0, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x00, 0x00, 0x00, 
-	0x00, 0x70, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0xC0, 0x00, 0x00, 0x00, 
+	0x70, 0x00, 
+	0x05, 0x49, 0x24, 0x88, 0x80, 
+	0x11, 0x12, 0x49, 0x2A, 0x00, 
+	0x01, 0x2A, 0xEA, 0x90, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x42, 0x7C, 0x84, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0xD8, 
+	0xF0, 0x33, 0xF0, 
+	0x00, 0x80, 
+	0x04, 0xA4, 0x94, 0x80, 0x00, 
+	0x03, 0xA3, 0x18, 0xC6, 0x31, 0x70, 0x00, 0x00, 
+	0x19, 0x24, 0x92, 0xE0, 0x00, 
+	0x03, 0xA2, 0x10, 0x88, 0x89, 0xF8, 0x00, 0x00, 
+	0x03, 0xA2, 0x13, 0x04, 0x21, 0xF0, 0x00, 0x00, 
+	0x00, 0x8C, 0xA5, 0x4B, 0xE2, 0x10, 0x00, 0x00, 
+	0x01, 0xD0, 0xC1, 0x04, 0x21, 0xF0, 0x00, 0x00, 
+	0x00, 0xD8, 0x8B, 0x66, 0x31, 0x70, 0x00, 0x00, 
+	0x03, 0xE2, 0x11, 0x08, 0x44, 0x20, 0x00, 0x00, 
+	0x03, 0xA3, 0x17, 0x2A, 0x31, 0x70, 0x00, 0x00, 
+	0x03, 0xA3, 0x18, 0xBC, 0x46, 0xC0, 0x00, 0x00, 
+	0x08, 0x80, 
+	0x00, 0x80, 0xD8, 
+	0x00, 0x00, 0x17, 0x41, 0xC1, 0x00, 0x00, 0x00, 
+	0xF0, 0x55, 0x55, 0xF0, 0xA0, 
+	0xF1, 0x53, 0x51, 0x13, 0x11, 0xF0, 0x90, 
+	0x06, 0x91, 0x24, 0x40, 0x40, 0x00, 
+	0x00, 0x0F, 0x08, 0x49, 0xD9, 0x2D, 0x26, 0x93, 0x4E, 0x98, 0x20, 0x48, 0x43, 0xC0, 
+	0x00, 0x20, 0x41, 0x42, 0x85, 0x1F, 0x22, 0xEE, 0x00, 0x00, 0x00, 
+	0x03, 0xE4, 0x51, 0x79, 0x14, 0x51, 0xF8, 0x00, 0x00, 
+	0x00, 0xF4, 0x60, 0x82, 0x08, 0x11, 0x38, 0x00, 0x00, 
+	0x01, 0xF1, 0x12, 0x14, 0x28, 0x50, 0xA2, 0xF8, 0x00, 0x00, 0x00, 
+	0x03, 0xF4, 0x54, 0x71, 0x44, 0x11, 0xFC, 0x00, 0x00, 
+	0x03, 0xF4, 0x54, 0x71, 0x44, 0x10, 0xE0, 0x00, 0x00, 
+	0x00, 0x79, 0x14, 0x08, 0x11, 0xE1, 0x22, 0x38, 0x00, 0x00, 0x00, 
+	0x01, 0xDD, 0x12, 0x27, 0xC8, 0x91, 0x22, 0xEE, 0x00, 0x00, 0x00, 
+	0x1D, 0x24, 0x92, 0xE0, 0x00, 
+	0x07, 0x22, 0x22, 0x22, 0xC0, 0x00, 
 	0x00, 0xEE, 0x48, 0x50, 0x60, 0x50, 0x48, 0x44, 0xEF, 0x00, 0x00, 0x00, 
-	0x00, 0xE0, 0x40, 0x40, 0x40, 0x40, 0x40, 0x44, 0xFC, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0xE3, 0x80, 0x63, 0x00, 0x63, 0x00, 0x55, 0x00, 0x55, 0x00, 0x55, 0x00, 0x49, 0x00, 0xEB, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0xCE, 0x44, 0x64, 0x54, 0x54, 0x4C, 0x44, 0xE4, 0x00, 0x00, 0x00, 
-	0x00, 0x38, 0x44, 0x82, 0x82, 0x82, 0x82, 0x44, 0x38, 0x00, 0x00, 0x00, 
-	0x00, 0xF8, 0x44, 0x44, 0x44, 0x78, 0x40, 0x40, 0xE0, 0x00, 0x00, 0x00, 
-	0x00, 0x38, 0x44, 0x82, 0x82, 0x82, 0x82, 0x44, 0x38, 0x08, 0x06, 0x00, 
-	0x00, 0xF8, 0x44, 0x44, 0x78, 0x50, 0x48, 0x48, 0xE6, 0x00, 0x00, 0x00, 
-	0x00, 0x70, 0x90, 0x80, 0x40, 0x20, 0x10, 0x90, 0xE0, 0x00, 0x00, 0x00, 
-	0x00, 0xFE, 0x92, 0x10, 0x10, 0x10, 0x10, 0x10, 0x38, 0x00, 0x00, 0x00, 
-	0x00, 0xEE, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 
-	0x00, 0xEE, 0x44, 0x44, 0x28, 0x28, 0x28, 0x10, 0x10, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0xEE, 0xE0, 0x44, 0x40, 0x44, 0x40, 0x24, 0x80, 0x2A, 0x80, 0x2A, 0x80, 0x11, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0xEE, 0x44, 0x28, 0x10, 0x10, 0x28, 0x44, 0xEE, 0x00, 0x00, 0x00, 
-	0x00, 0xEE, 0x44, 0x28, 0x28, 0x10, 0x10, 0x10, 0x38, 0x00, 0x00, 0x00, 
-	0x00, 0xFC, 0x88, 0x10, 0x20, 0x20, 0x40, 0x84, 0xFC, 0x00, 0x00, 0x00, 
-	0x00, 0xE0, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xE0, 0x00, 
-	0x00, 0x80, 0x80, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20, 0x00, 0x00, 0x00, 
-	0x00, 0xE0, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0xE0, 0x00, 
-	0x00, 0x60, 0x60, 0x90, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x00, 
-	0x00, 0x80, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x60, 0x10, 0x70, 0x90, 0x78, 0x00, 0x00, 0x00, 
-	0x00, 0xC0, 0x40, 0x40, 0x70, 0x48, 0x48, 0x48, 0x30, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x70, 0x90, 0x80, 0x80, 0x70, 0x00, 0x00, 0x00, 
-	0x00, 0x30, 0x10, 0x10, 0x70, 0x90, 0x90, 0x90, 0x78, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x60, 0x90, 0xF0, 0x80, 0x70, 0x00, 0x00, 0x00, 
-	0x00, 0x38, 0x48, 0x40, 0xE0, 0x40, 0x40, 0x40, 0xE0, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x78, 0x90, 0x60, 0x80, 0xF0, 0x88, 0x70, 0x00, 
-	0x00, 0xC0, 0x40, 0x40, 0x58, 0x68, 0x48, 0x48, 0xEC, 0x00, 0x00, 0x00, 
-	0x00, 0x40, 0x00, 0x00, 0xC0, 0x40, 0x40, 0x40, 0xE0, 0x00, 0x00, 0x00, 
-	0x00, 0x20, 0x00, 0x00, 0x60, 0x20, 0x20, 0x20, 0x20, 0x20, 0xC0, 0x00, 
-	0x00, 0xC0, 0x40, 0x40, 0x58, 0x50, 0x60, 0x50, 0xD8, 0x00, 0x00, 0x00, 
-	0x00, 0xC0, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xDB, 0x00, 0x6D, 0x00, 0x49, 0x00, 0x49, 0x00, 0xED, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0xD8, 0x68, 0x48, 0x48, 0xEC, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x70, 0x88, 0x88, 0x88, 0x70, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0xF0, 0x48, 0x48, 0x48, 0x70, 0x40, 0xE0, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x70, 0x90, 0x90, 0x90, 0x70, 0x10, 0x38, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0xD0, 0x60, 0x40, 0x40, 0xE0, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x60, 0x80, 0x60, 0x20, 0xC0, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x40, 0x40, 0xE0, 0x40, 0x40, 0x40, 0x60, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0xD8, 0x48, 0x48, 0x48, 0x3C, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0xDC, 0x48, 0x50, 0x20, 0x20, 0x00, 0x00, 0x00, 
+	0x03, 0x84, 0x10, 0x41, 0x04, 0x11, 0xFC, 0x00, 0x00, 
+	0x00, 0x71, 0xD8, 0xCC, 0x65, 0x52, 0xA9, 0x54, 0x92, 0xEB, 0x80, 0x00, 0x00, 0x00, 
+	0x01, 0x9D, 0x13, 0x25, 0x4A, 0x93, 0x22, 0xE4, 0x00, 0x00, 0x00, 
+	0x00, 0x71, 0x14, 0x18, 0x30, 0x60, 0xA2, 0x38, 0x00, 0x00, 0x00, 
+	0x03, 0xE4, 0x51, 0x45, 0xE4, 0x10, 0xE0, 0x00, 0x00, 
+	0x00, 0x71, 0x14, 0x18, 0x30, 0x60, 0xA2, 0x38, 0x10, 0x18, 0x00, 
+	0x01, 0xF1, 0x12, 0x27, 0x8A, 0x12, 0x24, 0xE6, 0x00, 0x00, 0x00, 
+	0x07, 0x98, 0x42, 0x19, 0xE0, 0x00, 
+	0x01, 0xFE, 0x48, 0x81, 0x02, 0x04, 0x08, 0x38, 0x00, 0x00, 0x00, 
+	0x01, 0xDD, 0x12, 0x24, 0x48, 0x91, 0x22, 0x38, 0x00, 0x00, 0x00, 
+	0x01, 0xDD, 0x12, 0x22, 0x85, 0x0A, 0x08, 0x10, 0x00, 0x00, 0x00, 
+	0x00, 0x1D, 0xDD, 0x11, 0x22, 0x22, 0x48, 0x55, 0x0A, 0xA0, 0x88, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x01, 0xDD, 0x11, 0x41, 0x02, 0x0A, 0x22, 0xEE, 0x00, 0x00, 0x00, 
+	0x01, 0xDD, 0x11, 0x42, 0x82, 0x04, 0x08, 0x38, 0x00, 0x00, 0x00, 
+	0x03, 0xF8, 0x84, 0x20, 0x84, 0x21, 0xFC, 0x00, 0x00, 
+	0x1E, 0x49, 0x24, 0x93, 0x80, 
+	0x12, 0x24, 0x91, 0x20, 0x00, 
+	0x1C, 0x92, 0x49, 0x27, 0x80, 
+	0x06, 0x69, 0x90, 0x00, 0x00, 0x00, 
+	0xF0, 0xF0, 0xF0, 0xF6, 0x60, 
+	0x24, 0x00, 0x00, 
+	0x00, 0x00, 0x06, 0x09, 0xD2, 0x78, 0x00, 0x00, 
+	0x06, 0x10, 0x87, 0x25, 0x29, 0x30, 0x00, 0x00, 
+	0x00, 0x00, 0x79, 0x88, 0x70, 0x00, 
+	0x01, 0x84, 0x27, 0x4A, 0x52, 0x78, 0x00, 0x00, 
+	0x00, 0x00, 0x69, 0xF8, 0x70, 0x00, 
+	0x01, 0xD2, 0x8E, 0x21, 0x08, 0xE0, 0x00, 0x00, 
+	0x00, 0x00, 0x07, 0xC9, 0x90, 0xF4, 0x5C, 0x00, 
+	0x03, 0x04, 0x10, 0x59, 0xA4, 0x92, 0xEC, 0x00, 0x00, 
+	0x08, 0x0C, 0x92, 0xE0, 0x00, 
+	0x04, 0x06, 0x49, 0x27, 0x00, 
+	0x06, 0x10, 0x85, 0xA9, 0x8A, 0xD8, 0x00, 0x00, 
+	0x19, 0x24, 0x92, 0xE0, 0x00, 
+	0x00, 0x00, 0x00, 0x00, 0x0D, 0xB3, 0x69, 0x24, 0x92, 0xED, 0x80, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0xD9, 0xA4, 0x92, 0xEC, 0x00, 0x00, 
+	0x00, 0x00, 0x07, 0x46, 0x31, 0x70, 0x00, 0x00, 
+	0x00, 0x00, 0x0F, 0x25, 0x29, 0x72, 0x38, 0x00, 
+	0x00, 0x00, 0x07, 0x4A, 0x52, 0x70, 0x8E, 0x00, 
+	0x00, 0x00, 0xD6, 0x44, 0xE0, 0x00, 
+	0xD3, 0x32, 0x23, 0xA0, 
+	0x01, 0x2E, 0x92, 0x60, 0x00, 
+	0x00, 0x00, 0x00, 0xD9, 0x24, 0x92, 0x3C, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0xDD, 0x25, 0x08, 0x20, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0xDB, 0x4A, 0x5A, 0x24, 0x24, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0xD8, 0x50, 0x20, 0x50, 0xD8, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0xDC, 0x48, 0x50, 0x30, 0x20, 0x20, 0xC0, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0xF8, 0x90, 0x20, 0x48, 0xF8, 0x00, 0x00, 0x00, 
-	0x00, 0x20, 0x40, 0x40, 0x40, 0x80, 0x40, 0x40, 0x40, 0x40, 0x20, 0x00, 
-	0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 
-	0x00, 0x80, 0x40, 0x40, 0x40, 0x20, 0x40, 0x40, 0x40, 0x40, 0x80, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0xE8, 0xB8, 0x00, 0x00, 0x00, 0x00, 0x00, 
+	0x00, 0x00, 0x0D, 0xA8, 0x8A, 0xD8, 0x00, 0x00, 
+	0x00, 0x00, 0x00, 0xDD, 0x25, 0x0C, 0x20, 0x8C, 0x00, 
+	0xF0, 0x56, 0x21, 0x31, 0x31, 0x26, 0xF0, 
+	0x05, 0x25, 0x12, 0x48, 0x80, 
+	0x7F, 0xE0, 
+	0x11, 0x24, 0x52, 0x4A, 0x00, 
+	0xF0, 0xA3, 0x12, 0x13, 0xF0, 0xA0, 
+	
 };
 
-
-// Character bitmaps for timesNewRoman 8pt
+// Character descriptors for timesNewRoman 8pt
+// { [Char width in bits], [Char height in bits], [Offset into timesNewRoman_8ptBitmaps in bytes] }
 const FontDescriptor timesNewRoman_8ptDescriptors[] =
 {
-	{2, 12, 0}, 	
-	{1, 12, 12}, 	
-	{3, 12, 24}, 	
-	{6, 12, 36}, 	
-	{5, 12, 48}, 	
-	{9, 12, 60}, 	
-	{8, 12, 84}, 	
-	{1, 12, 96}, 	
-	{3, 12, 108}, 	
-	{3, 12, 120}, 	
-	{5, 12, 132}, 	
-	{5, 12, 144}, 	
-	{2, 12, 156}, 	
-	{3, 12, 168}, 	
-	{1, 12, 180}, 	
-	{3, 12, 192}, 	
-	{5, 12, 204}, 	
-	{3, 12, 216}, 	
-	{5, 12, 228}, 	
-	{5, 12, 240}, 	
-	{5, 12, 252}, 	
-	{5, 12, 264}, 	
-	{5, 12, 276}, 	
-	{5, 12, 288}, 	
-	{5, 12, 300}, 	
-	{5, 12, 312}, 	
-	{1, 12, 324}, 	
-	{2, 12, 336}, 	
-	{5, 12, 348}, 	
-	{5, 12, 360}, 	
-	{5, 12, 372}, 	
-	{4, 12, 384}, 	
-	{9, 12, 396}, 	
-	{7, 12, 420}, 	
-	{6, 12, 432}, 	
-	{6, 12, 444}, 	
-	{7, 12, 456}, 	
-	{6, 12, 468}, 	
-	{6, 12, 480}, 	
-	{7, 12, 492}, 	
-	{7, 12, 504}, 	
-	{3, 12, 516}, 	
-	{4, 12, 528}, 	
-	{8, 12, 540}, 	
-	{6, 12, 552}, 	
-	{9, 12, 564}, 	
-	{7, 12, 588}, 	
-	{7, 12, 600}, 	
-	{6, 12, 612}, 	
-	{7, 12, 624}, 	
-	{7, 12, 636}, 	
-	{4, 12, 648}, 	
-	{7, 12, 660}, 	
-	{7, 12, 672}, 	
-	{7, 12, 684}, 	
-	{11, 12, 696}, 	
-	{7, 12, 720}, 	
-	{7, 12, 732}, 	
-	{6, 12, 744}, 	
-	{3, 12, 756}, 	
-	{3, 12, 768}, 	
-	{3, 12, 780}, 	
-	{4, 12, 792}, 	
-	{6, 12, 804}, 	
-	{2, 12, 816}, 	
-	{5, 12, 828}, 	
-	{5, 12, 840}, 	
-	{4, 12, 852}, 	
-	{5, 12, 864}, 	
-	{4, 12, 876}, 	
-	{5, 12, 888}, 	
-	{5, 12, 900}, 	
-	{6, 12, 912}, 	
-	{3, 12, 924}, 	
-	{3, 12, 936}, 	
-	{5, 12, 948}, 	
-	{3, 12, 960}, 	
-	{9, 12, 972}, 	
-	{6, 12, 996}, 	
-	{5, 12, 1008}, 	
-	{5, 12, 1020}, 	
-	{5, 12, 1032}, 	
-	{4, 12, 1044}, 	
-	{3, 12, 1056}, 	
-	{3, 12, 1068}, 	
-	{6, 12, 1080}, 	
-	{6, 12, 1092}, 	
-	{8, 12, 1104}, 	
-	{5, 12, 1116}, 	
-	{6, 12, 1128}, 	
-	{5, 12, 1140}, 	
-	{3, 12, 1152}, 	
-	{1, 12, 1164}, 	
-	{3, 12, 1176}, 	
-	{5, 12, 1188}, 	
+	{2, 12, 0 | FONT_RLE_GLYPH}, 	// 0x20
+	{1, 12, 2}, 	// '!'
+	{3, 12, 4}, 	// '"'
+	{6, 12, 9}, 	// '#'
+	{5, 12, 18}, 	// '$'
+	{9, 12, 26}, 	// '%'
+	{8, 12, 40}, 	// '&'
+	{1, 12, 52}, 	// '''
+	{3, 12, 54}, 	// '('
+	{3, 12, 59}, 	// ')'
+	{5, 12, 64}, 	// '*'
+	{5, 12, 72}, 	// '+'
+	{2, 12, 80}, 	// ','
+	{3, 12, 83 | FONT_RLE_GLYPH}, 	// '-'
+	{1, 12, 86}, 	// '.'
+	{3, 12, 88}, 	// '/'
+	{5, 12, 93}, 	// '0'
+	{3, 12, 101}, 	// '1'
+	{5, 12, 106}, 	// '2'
+	{5, 12, 114}, 	// '3'
+	{5, 12, 122}, 	// '4'
+	{5, 12, 130}, 	// '5'
+	{5, 12, 138}, 	// '6'
+	{5, 12, 146}, 	// '7'
+	{5, 12, 154}, 	// '8'
+	{5, 12, 162}, 	// '9'
+	{1, 12, 170}, 	// ':'
+	{2, 12, 172}, 	// ';'
+	{5, 12, 175}, 	// '<'
+	{5, 12, 183 | FONT_RLE_GLYPH}, 	// '='
+	{5, 12, 188 | FONT_RLE_GLYPH}, 	// '>'
+	{4, 12, 195}, 	// '?'
+	{9, 12, 201}, 	// '@'
+	{7, 12, 215}, 	// 'A'
+	{6, 12, 226}, 	// 'B'
+	{6, 12, 235}, 	// 'C'
+	{7, 12, 244}, 	// 'D'
+	{6, 12, 255}, 	// 'E'
+	{6, 12, 264}, 	// 'F'
+	{7, 12, 273}, 	// 'G'
+	{7, 12, 284}, 	// 'H'
+	{3, 12, 295}, 	// 'I'
+	{4, 12, 300}, 	// 'J'
+	{8, 12, 306}, 	// 'K'
+	{6, 12, 318}, 	// 'L'
+	{9, 12, 327}, 	// 'M'
+	{7, 12, 341}, 	// 'N'
+	{7, 12, 352}, 	// 'O'
+	{6, 12, 363}, 	// 'P'
+	{7, 12, 372}, 	// 'Q'
+	{7, 12, 383}, 	// 'R'
+	{4, 12, 394}, 	// 'S'
+	{7, 12, 400}, 	// 'T'
+	{7, 12, 411}, 	// 'U'
+	{7, 12, 422}, 	// 'V'
+	{11, 12, 433}, 	// 'W'
+	{7, 12, 450}, 	// 'X'
+	{7, 12, 461}, 	// 'Y'
+	{6, 12, 472}, 	// 'Z'
+	{3, 12, 481}, 	// '['
+	{3, 12, 486}, 	// 0x5C
+	{3, 12, 491}, 	// ']'
+	{4, 12, 496}, 	// '^'
+	{6, 12, 502 | FONT_RLE_GLYPH}, 	// '_'
+	{2, 12, 507}, 	// '`'
+	{5, 12, 510}, 	// 'a'
+	{5, 12, 518}, 	// 'b'
+	{4, 12, 526}, 	// 'c'
+	{5, 12, 532}, 	// 'd'
+	{4, 12, 540}, 	// 'e'
+	{5, 12, 546}, 	// 'f'
+	{5, 12, 554}, 	// 'g'
+	{6, 12, 562}, 	// 'h'
+	{3, 12, 571}, 	// 'i'
+	{3, 12, 576}, 	// 'j'
+	{5, 12, 581}, 	// 'k'
+	{3, 12, 589}, 	// 'l'
+	{9, 12, 594}, 	// 'm'
+	{6, 12, 608}, 	// 'n'
+	{5, 12, 617}, 	// 'o'
+	{5, 12, 625}, 	// 'p'
+	{5, 12, 633}, 	// 'q'
+	{4, 12, 641}, 	// 'r'
+	{3, 12, 647 | FONT_RLE_GLYPH}, 	// 's'
+	{3, 12, 651}, 	// 't'
+	{6, 12, 656}, 	// 'u'
+	{6, 12, 665}, 	// 'v'
+	{8, 12, 674}, 	// 'w'
+	{5, 12, 686}, 	// 'x'
+	{6, 12, 694}, 	// 'y'
+	{5, 12, 703 | FONT_RLE_GLYPH}, 	// 'z'
+	{3, 12, 710}, 	// '{'
+	{1, 12, 715}, 	// '|'
+	{3, 12, 717}, 	// '}'
+	{5, 12, 722 | FONT_RLE_GLYPH}, 	// '~'
+	{0, 0, 728}, 	// 0x7F
 };
 #endif	//TIMESNEWROMAN8
 
@@ -1344,6 +1346,336 @@ const FontDescriptor glcdfontDescriptors[] =
 	{5,8,2040} 	
 };
 
+#ifdef TINY3X5
+// Character bitmaps for 3x5 pixel font, FONT_BITS packing
+const uint8_t font3x5Bitmaps[] = 
+{
+	0x20, 0x7A,		// Start Character, End Character
+	0x00, 0x00, 
+	0x49, 0x04, 
+	0xB4, 0x00, 
+	0xBE, 0xFA, 
+	0x79, 0x3C, 
+	0xA5, 0x4A, 
+	0x55, 0x56, 
+	0x48, 0x00, 
+	0x29, 0x22, 
+	0x89, 0x28, 
+	0x15, 0x50, 
+	0x0B, 0xA0, 
+	0x00, 0x28, 
+	0x03, 0x80, 
+	0x00, 0x04, 
+	0x25, 0x48, 
+	0xF6, 0xDE, 
+	0x59, 0x2E, 
+	0xE7, 0xCE, 
+	0xE7, 0x9E, 
+	0xB7, 0x92, 
+	0xF3, 0x9E, 
+	0xF3, 0xDE, 
+	0xE4, 0x92, 
+	0xF7, 0xDE, 
+	0xF7, 0x92, 
+	0x08, 0x20, 
+	0x08, 0x28, 
+	0x2A, 0x22, 
+	0x1C, 0x70, 
+	0x88, 0xA8, 
+	0xE5, 0x04, 
+	0x57, 0xC6, 
+	0xF7, 0xDA, 
+	0xF7, 0xDE, 
+	0xF2, 0x4E, 
+	0xF6, 0xDE, 
+	0xF3, 0xCE, 
+	0xF3, 0x48, 
+	0xF2, 0xDE, 
+	0xB7, 0xDA, 
+	0xE9, 0x2E, 
+	0x26, 0xDE, 
+	0xBA, 0x6A, 
+	0x92, 0x4E, 
+	0xBF, 0xDA, 
+	0xF6, 0xDA, 
+	0x56, 0xD4, 
+	0xF7, 0xC8, 
+	0xF6, 0xE6, 
+	0xF7, 0xEA, 
+	0xF3, 0x9E, 
+	0xE9, 0x24, 
+	0xB6, 0xDE, 
+	0xB6, 0xD4, 
+	0xB6, 0xFA, 
+	0xB5, 0x5A, 
+	0xB5, 0x24, 
+	0xE5, 0x4E, 
+};
+
+// Character descriptors for 3x5 pixel font
+// { [Char width in bits], [Char height in bits], [Offset into font3x5Bitmaps in bytes] }
+const FontDescriptor font3x5Descriptors[] =
+{
+	{3, 5, 0}, 	// 0x20
+	{3, 5, 2}, 	// '!'
+	{3, 5, 4}, 	// '"'
+	{3, 5, 6}, 	// '#'
+	{3, 5, 8}, 	// '$'
+	{3, 5, 10}, 	// '%'
+	{3, 5, 12}, 	// '&'
+	{3, 5, 14}, 	// '''
+	{3, 5, 16}, 	// '('
+	{3, 5, 18}, 	// ')'
+	{3, 5, 20}, 	// '*'
+	{3, 5, 22}, 	// '+'
+	{3, 5, 24}, 	// ','
+	{3, 5, 26}, 	// '-'
+	{3, 5, 28}, 	// '.'
+	{3, 5, 30}, 	// '/'
+	{3, 5, 32}, 	// '0'
+	{3, 5, 34}, 	// '1'
+	{3, 5, 36}, 	// '2'
+	{3, 5, 38}, 	// '3'
+	{3, 5, 40}, 	// '4'
+	{3, 5, 42}, 	// '5'
+	{3, 5, 44}, 	// '6'
+	{3, 5, 46}, 	// '7'
+	{3, 5, 48}, 	// '8'
+	{3, 5, 50}, 	// '9'
+	{3, 5, 52}, 	// ':'
+	{3, 5, 54}, 	// ';'
+	{3, 5, 56}, 	// '<'
+	{3, 5, 58}, 	// '='
+	{3, 5, 60}, 	// '>'
+	{3, 5, 62}, 	// '?'
+	{3, 5, 64}, 	// '@'
+	{3, 5, 66}, 	// 'A'
+	{3, 5, 68}, 	// 'B'
+	{3, 5, 70}, 	// 'C'
+	{3, 5, 72}, 	// 'D'
+	{3, 5, 74}, 	// 'E'
+	{3, 5, 76}, 	// 'F'
+	{3, 5, 78}, 	// 'G'
+	{3, 5, 80}, 	// 'H'
+	{3, 5, 82}, 	// 'I'
+	{3, 5, 84}, 	// 'J'
+	{3, 5, 86}, 	// 'K'
+	{3, 5, 88}, 	// 'L'
+	{3, 5, 90}, 	// 'M'
+	{3, 5, 92}, 	// 'N'
+	{3, 5, 94}, 	// 'O'
+	{3, 5, 96}, 	// 'P'
+	{3, 5, 98}, 	// 'Q'
+	{3, 5, 100}, 	// 'R'
+	{3, 5, 102}, 	// 'S'
+	{3, 5, 104}, 	// 'T'
+	{3, 5, 106}, 	// 'U'
+	{3, 5, 108}, 	// 'V'
+	{3, 5, 110}, 	// 'W'
+	{3, 5, 112}, 	// 'X'
+	{3, 5, 114}, 	// 'Y'
+	{3, 5, 116}, 	// 'Z'
+	// [ to ` are blank, a-z share the A-Z bitmaps
+	{3, 5, 0}, 	// '['
+	{3, 5, 0}, 	// 0x5C
+	{3, 5, 0}, 	// ']'
+	{3, 5, 0}, 	// '^'
+	{3, 5, 0}, 	// '_'
+	{3, 5, 0}, 	// '`'
+	{3, 5, 66}, 	// 'a'
+	{3, 5, 68}, 	// 'b'
+	{3, 5, 70}, 	// 'c'
+	{3, 5, 72}, 	// 'd'
+	{3, 5, 74}, 	// 'e'
+	{3, 5, 76}, 	// 'f'
+	{3, 5, 78}, 	// 'g'
+	{3, 5, 80}, 	// 'h'
+	{3, 5, 82}, 	// 'i'
+	{3, 5, 84}, 	// 'j'
+	{3, 5, 86}, 	// 'k'
+	{3, 5, 88}, 	// 'l'
+	{3, 5, 90}, 	// 'm'
+	{3, 5, 92}, 	// 'n'
+	{3, 5, 94}, 	// 'o'
+	{3, 5, 96}, 	// 'p'
+	{3, 5, 98}, 	// 'q'
+	{3, 5, 100}, 	// 'r'
+	{3, 5, 102}, 	// 's'
+	{3, 5, 104}, 	// 't'
+	{3, 5, 106}, 	// 'u'
+	{3, 5, 108}, 	// 'v'
+	{3, 5, 110}, 	// 'w'
+	{3, 5, 112}, 	// 'x'
+	{3, 5, 114}, 	// 'y'
+	{3, 5, 116}, 	// 'z'
+};
+#endif	//TINY3X5
+
+#ifdef TINY5X5
+// Character bitmaps for 5x5 pixel font, FONT_BITS packing
+const uint8_t font5x5Bitmaps[] = 
+{
+	0x20, 0x7A,		// Start Character, End Character
+	0x00, 0x00, 0x00, 0x00, 
+	0x21, 0x08, 0x02, 0x00, 
+	0x52, 0x80, 0x00, 0x00, 
+	0x57, 0xD5, 0xF5, 0x00, 
+	0x7D, 0x1C, 0x5F, 0x00, 
+	0xCE, 0x88, 0xB9, 0x80, 
+	0x64, 0x9B, 0x26, 0x80, 
+	0x21, 0x00, 0x00, 0x00, 
+	0x11, 0x08, 0x41, 0x00, 
+	0x41, 0x08, 0x44, 0x00, 
+	0x02, 0x88, 0xA0, 0x00, 
+	0x01, 0x1C, 0x40, 0x00, 
+	0x00, 0x00, 0x44, 0x00, 
+	0x00, 0x1C, 0x00, 0x00, 
+	0x00, 0x00, 0x02, 0x00, 
+	0x08, 0x88, 0x88, 0x00, 
+	0xFC, 0xEB, 0x9F, 0x80, 
+	0x23, 0x08, 0x47, 0x00, 
+	0xF0, 0x5D, 0x0F, 0x80, 
+	0xF8, 0x5C, 0x1F, 0x80, 
+	0x84, 0x29, 0xF2, 0x00, 
+	0xFC, 0x3C, 0x1F, 0x00, 
+	0xFC, 0x3F, 0x1F, 0x80, 
+	0xF8, 0x44, 0x42, 0x00, 
+	0xFC, 0x7F, 0x1F, 0x80, 
+	0xFC, 0x7E, 0x1F, 0x80, 
+	0x01, 0x00, 0x40, 0x00, 
+	0x01, 0x00, 0x44, 0x00, 
+	0x11, 0x10, 0x41, 0x00, 
+	0x03, 0x80, 0xE0, 0x00, 
+	0x41, 0x04, 0x44, 0x00, 
+	0x74, 0x4C, 0x02, 0x00, 
+	0x74, 0x6F, 0x07, 0x00, 
+	0xFC, 0x63, 0xF8, 0x80, 
+	0xFC, 0x7D, 0x1F, 0x80, 
+	0xFC, 0x21, 0x0F, 0x80, 
+	0xF4, 0x63, 0x1F, 0x00, 
+	0xFC, 0x3D, 0x0F, 0x80, 
+	0xFC, 0x39, 0x08, 0x00, 
+	0xFC, 0x27, 0x1F, 0x80, 
+	0x8C, 0x7F, 0x18, 0x80, 
+	0xF9, 0x08, 0x4F, 0x80, 
+	0x18, 0x43, 0x1F, 0x80, 
+	0x8C, 0xB9, 0x28, 0x80, 
+	0x84, 0x21, 0x0F, 0x80, 
+	0x8E, 0xEB, 0x18, 0x80, 
+	0x8E, 0x6B, 0x38, 0x80, 
+	0x74, 0x63, 0x17, 0x00, 
+	0xF4, 0x7D, 0x08, 0x00, 
+	0xFC, 0x63, 0xF2, 0x00, 
+	0xF4, 0x7D, 0x18, 0x80, 
+	0xFC, 0x3E, 0x1F, 0x80, 
+	0xF9, 0x08, 0x42, 0x00, 
+	0x8C, 0x63, 0x1F, 0x80, 
+	0x8C, 0x54, 0xA2, 0x00, 
+	0x8C, 0x6B, 0x55, 0x00, 
+	0x8A, 0x88, 0xA8, 0x80, 
+	0x8C, 0x54, 0x42, 0x00, 
+	0xF8, 0x88, 0x8F, 0x80, 
+};
+
+// Character descriptors for 5x5 pixel font
+// { [Char width in bits], [Char height in bits], [Offset into font5x5Bitmaps in bytes] }
+const FontDescriptor font5x5Descriptors[] =
+{
+	{5, 5, 0}, 	// 0x20
+	{5, 5, 4}, 	// '!'
+	{5, 5, 8}, 	// '"'
+	{5, 5, 12}, 	// '#'
+	{5, 5, 16}, 	// '$'
+	{5, 5, 20}, 	// '%'
+	{5, 5, 24}, 	// '&'
+	{5, 5, 28}, 	// '''
+	{5, 5, 32}, 	// '('
+	{5, 5, 36}, 	// ')'
+	{5, 5, 40}, 	// '*'
+	{5, 5, 44}, 	// '+'
+	{5, 5, 48}, 	// ','
+	{5, 5, 52}, 	// '-'
+	{5, 5, 56}, 	// '.'
+	{5, 5, 60}, 	// '/'
+	{5, 5, 64}, 	// '0'
+	{5, 5, 68}, 	// '1'
+	{5, 5, 72}, 	// '2'
+	{5, 5, 76}, 	// '3'
+	{5, 5, 80}, 	// '4'
+	{5, 5, 84}, 	// '5'
+	{5, 5, 88}, 	// '6'
+	{5, 5, 92}, 	// '7'
+	{5, 5, 96}, 	// '8'
+	{5, 5, 100}, 	// '9'
+	{5, 5, 104}, 	// ':'
+	{5, 5, 108}, 	// ';'
+	{5, 5, 112}, 	// '<'
+	{5, 5, 116}, 	// '='
+	{5, 5, 120}, 	// '>'
+	{5, 5, 124}, 	// '?'
+	{5, 5, 128}, 	// '@'
+	{5, 5, 132}, 	// 'A'
+	{5, 5, 136}, 	// 'B'
+	{5, 5, 140}, 	// 'C'
+	{5, 5, 144}, 	// 'D'
+	{5, 5, 148}, 	// 'E'
+	{5, 5, 152}, 	// 'F'
+	{5, 5, 156}, 	// 'G'
+	{5, 5, 160}, 	// 'H'
+	{5, 5, 164}, 	// 'I'
+	{5, 5, 168}, 	// 'J'
+	{5, 5, 172}, 	// 'K'
+	{5, 5, 176}, 	// 'L'
+	{5, 5, 180}, 	// 'M'
+	{5, 5, 184}, 	// 'N'
+	{5, 5, 188}, 	// 'O'
+	{5, 5, 192}, 	// 'P'
+	{5, 5, 196}, 	// 'Q'
+	{5, 5, 200}, 	// 'R'
+	{5, 5, 204}, 	// 'S'
+	{5, 5, 208}, 	// 'T'
+	{5, 5, 212}, 	// 'U'
+	{5, 5, 216}, 	// 'V'
+	{5, 5, 220}, 	// 'W'
+	{5, 5, 224}, 	// 'X'
+	{5, 5, 228}, 	// 'Y'
+	{5, 5, 232}, 	// 'Z'
+	// [ to ` are blank, a-z share the A-Z bitmaps
+	{5, 5, 0}, 	// '['
+	{5, 5, 0}, 	// 0x5C
+	{5, 5, 0}, 	// ']'
+	{5, 5, 0}, 	// '^'
+	{5, 5, 0}, 	// '_'
+	{5, 5, 0}, 	// '`'
+	{5, 5, 132}, 	// 'a'
+	{5, 5, 136}, 	// 'b'
+	{5, 5, 140}, 	// 'c'
+	{5, 5, 144}, 	// 'd'
+	{5, 5, 148}, 	// 'e'
+	{5, 5, 152}, 	// 'f'
+	{5, 5, 156}, 	// 'g'
+	{5, 5, 160}, 	// 'h'
+	{5, 5, 164}, 	// 'i'
+	{5, 5, 168}, 	// 'j'
+	{5, 5, 172}, 	// 'k'
+	{5, 5, 176}, 	// 'l'
+	{5, 5, 180}, 	// 'm'
+	{5, 5, 184}, 	// 'n'
+	{5, 5, 188}, 	// 'o'
+	{5, 5, 192}, 	// 'p'
+	{5, 5, 196}, 	// 'q'
+	{5, 5, 200}, 	// 'r'
+	{5, 5, 204}, 	// 's'
+	{5, 5, 208}, 	// 't'
+	{5, 5, 212}, 	// 'u'
+	{5, 5, 216}, 	// 'v'
+	{5, 5, 220}, 	// 'w'
+	{5, 5, 224}, 	// 'x'
+	{5, 5, 228}, 	// 'y'
+	{5, 5, 232}, 	// 'z'
+};
+#endif	//TINY5X5
+
 #ifdef TESTFONT
 const uint8_t testBitmaps[] =
 {
@@ -20,6 +20,8 @@ Please read README.pdf for details
 //#define ARIAL8
 //#define COMICSANSMS8
 //#define TESTFONT
+#define TINY3X5		// 3x5 and 5x5 pixel fonts used by RGBPongClock
+#define TINY5X5
 
 // Font selection descriptors - Add an entry for each new font and number sequentially
 #define TIMESNR_8	0
@@ -28,10 +30,23 @@ Please read README.pdf for details
 #define COMICS_8	3
 #define GLCDFONT	4
 #define TEST		5
+#define FONT_3X5	6
+#define FONT_5X5	7
 
 #define FONT_START 0
 #define FONT_END 1
 
+// Glyph bitmap packing - tools/fontconv generates either
+#define FONT_ROWS	0	// Every glyph row padded to whole bytes
+#define FONT_BITS	1	// Rows run on bit to bit, only the glyph end is padded
+#define FONT_RLE	2	// Per glyph, FONT_BITS or run-length coded (below)
+
+// FONT_RLE glyphs with this bit set in their descriptor offset are stored
+// as 4-bit run lengths, high nibble first, alternating background and ink
+// (background first).  A zero run just switches colour, so runs longer
+// than 15 are coded as 15, 0, rest.
+#define FONT_RLE_GLYPH	0x8000
+
 struct FontDescriptor
 {
 	uint8_t	width;		// width in bits
@@ -63,6 +78,16 @@ extern const FontDescriptor comicSansMS_8ptDescriptors[];
 extern const uint8_t glcdfontBitmaps[];
 extern const FontDescriptor glcdfontDescriptors[];
 
+#ifdef TINY3X5
+extern const uint8_t font3x5Bitmaps[];
+extern const FontDescriptor font3x5Descriptors[];
+#endif
+
+#ifdef TINY5X5
+extern const uint8_t font5x5Bitmaps[];
+extern const FontDescriptor font5x5Descriptors[];
+#endif
+
 #ifdef TESTFONT
 extern const uint8_t testBitmaps[];
 extern const FontDescriptor testDescriptors[];
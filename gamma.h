@@ -3,39 +3,87 @@
 
 #include "application.h"
 
-static const uint8_t gamma[] = {
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x01,
-  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,
-  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,
-  0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,
-  0x01,0x01,0x01,0x01,0x01,0x01,0x02,0x02,
-  0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,
-  0x02,0x02,0x02,0x02,0x02,0x02,0x02,0x02,
-  0x02,0x02,0x02,0x02,0x02,0x03,0x03,0x03,
-  0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,
-  0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x04,
-  0x04,0x04,0x04,0x04,0x04,0x04,0x04,0x04,
-  0x04,0x04,0x04,0x04,0x04,0x04,0x05,0x05,
-  0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,
-  0x05,0x05,0x05,0x06,0x06,0x06,0x06,0x06,
-  0x06,0x06,0x06,0x06,0x06,0x06,0x06,0x07,
-  0x07,0x07,0x07,0x07,0x07,0x07,0x07,0x07,
-  0x07,0x07,0x08,0x08,0x08,0x08,0x08,0x08,
-  0x08,0x08,0x08,0x08,0x09,0x09,0x09,0x09,
-  0x09,0x09,0x09,0x09,0x09,0x0a,0x0a,0x0a,
-  0x0a,0x0a,0x0a,0x0a,0x0a,0x0a,0x0b,0x0b,
-  0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0c,0x0c,
-  0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0d,0x0d,
-  0x0d,0x0d,0x0d,0x0d,0x0d,0x0e,0x0e,0x0e,
-  0x0e,0x0e,0x0e,0x0e,0x0f,0x0f,0x0f,0x0f
+/*
+ Gamma correction tables, generated by the compiler instead of pasted in.
+
+   GammaTable<Bits, ExponentX100, Brightness>::table[256]
+
+ maps an 8-bit linear input to a Bits-bit output level:
+
+   table[i] = round(((i / 255) * (Brightness / 255)) ^ (ExponentX100 / 100)
+                    * (2^Bits - 1))
+
+ Brightness scales the input, the same way ColorHSV() applies 'val', so a
+ dimmed table still costs only one lookup per channel.  With the defaults
+ below (exponent 2.5, full brightness, 4 bits) this is the table the
+ library has always shipped with.
+
+ Everything is evaluated at compile time, so the tables are plain const
+ data in flash; the float math below never runs on the Core.
+*/
+
+#ifndef GAMMA_EXPONENT_X100
+#define GAMMA_EXPONENT_X100	250		// 2.5
+#endif
+#ifndef GAMMA_BRIGHTNESS
+#define GAMMA_BRIGHTNESS	255		// 0 - 255
+#endif
+
+namespace gammagen {
+
+// ln(x) = 2 * atanh((x - 1) / (x + 1)), with x first brought into
+// [0.5, 1] so the series converges quickly
+constexpr double atanhSeries(double z2, double term, int n) {
+	return n > 40 ? 0 : term / (2 * n + 1) + atanhSeries(z2, term * z2, n + 1);
+}
+constexpr double ln(double x) {
+	return x < 0.5 ? ln(x * 2) - 0.69314718055994531 :
+	       2 * ((x - 1) / (x + 1)) *
+	       atanhSeries(((x - 1) / (x + 1)) * ((x - 1) / (x + 1)), 1.0, 0);
+}
+
+// exp(y) for y <= 0, halving y until the Taylor series converges quickly
+constexpr double expSeries(double y, double term, int n) {
+	return n > 25 ? 0 : term + expSeries(y, term * y / (n + 1), n + 1);
+}
+constexpr double squared(double v) {
+	return v * v;
+}
+constexpr double exp(double y) {
+	return y < -0.5 ? squared(exp(y / 2)) : expSeries(y, 1.0, 0);
+}
+
+constexpr double pow(double x, double e) {
+	return x <= 0 ? 0 : exp(e * ln(x));
+}
+
+constexpr uint8_t level(int i, int bits, int exponentX100, int brightness) {
+	return (uint8_t)(pow(i / 255.0 * (brightness / 255.0), exponentX100 / 100.0) *
+	                 ((1 << bits) - 1) + 0.5);
+}
+
+// 0, 1, ... 255 as a template parameter pack
+template<int... I> struct Seq {};
+template<int N, int... I> struct MakeSeq : MakeSeq<N - 1, N - 1, I...> {};
+template<int... I> struct MakeSeq<0, I...> { typedef Seq<I...> type; };
+
+template<int Bits, int ExponentX100, int Brightness, class S> struct Table;
+template<int Bits, int ExponentX100, int Brightness, int... I>
+struct Table<Bits, ExponentX100, Brightness, Seq<I...> > {
+	static const uint8_t table[256];
+};
+template<int Bits, int ExponentX100, int Brightness, int... I>
+const uint8_t Table<Bits, ExponentX100, Brightness, Seq<I...> >::table[256] =
+	{ level(I, Bits, ExponentX100, Brightness)... };
+
+}	// namespace gammagen
+
+template<int Bits, int ExponentX100 = GAMMA_EXPONENT_X100,
+	int Brightness = GAMMA_BRIGHTNESS>
+struct GammaTable : gammagen::Table<Bits, ExponentX100, Brightness,
+	gammagen::MakeSeq<256>::type> {
+	static_assert(Bits >= 1 && Bits <= 8, "gamma output must be 1 to 8 bits");
+	static_assert(Brightness >= 0 && Brightness <= 255, "brightness is 0 - 255");
 };
 
 #endif // _GAMMA_H_
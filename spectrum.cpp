@@ -0,0 +1,255 @@
+/*
+ FFT bins to display columns, see spectrum.h.
+*/
+
+#include "spectrum.h"
+#include "fix_fft.h"
+#include "fixmath.h"
+#include "window.h"
+#include <math.h>
+
+void spectrumMagnitudes(const uint16_t samples[], int16_t data[],
+	uint8_t window, uint8_t start)
+{
+	const int16_t *w = windowTable<int16_t, SPECTRUM_POINTS>(window);
+	int16_t  scale;
+	uint16_t i;
+
+	// 12 bit ADC to Q15, unwrapped and windowed on the way in (* 16, not
+	// << 4: the centred samples are negative half the time)
+	if (w) {
+		for (i = 0; i < SPECTRUM_POINTS; i++, start++)
+			data[i] = ((int32_t)((samples[start & (SPECTRUM_POINTS - 1)] - 2048)
+				* 16) * w[i]) >> 15;
+	}
+	else {
+		for (i = 0; i < SPECTRUM_POINTS; i++, start++)
+			data[i] = (samples[start & (SPECTRUM_POINTS - 1)] - 2048) * 16;
+	}
+
+	// Real input FFT, 16 bit with block floating point: bin k comes
+	// back as re in data[k] and im in data[k + N/2], to be shifted
+	// left by 'scale'
+	scale = fix_fftr(data, SPECTRUM_LOG2N, 0);
+	if (w)
+		scale += WINDOW_GAIN_SHIFT;	// Make up for the window's loss
+
+	// Scaled down to 1/N of an 8 bit sample, the units the display
+	// levels were tuned for
+	data[0] = 0;
+	for (i = 1; i < SPECTRUM_POINTS / 2; i++)
+		data[i] = ((uint32_t)fix_hypot(data[i], data[i + SPECTRUM_POINTS / 2])
+			<< scale) >> 15;
+}
+
+void spectrumLogMap(uint16_t edges[], uint8_t columns, uint16_t firstBin,
+	uint16_t bins)
+{
+	uint16_t c, next, cur = firstBin;
+
+	edges[0] = cur;
+	for (c = 0; c < columns; c++) {
+		/*
+		 Split what is left of the range evenly, on a log scale,
+		 between the columns still to fill.  Columns forced to
+		 one bin at the low end leave the others a little more.
+		*/
+		if (cur >= bins)
+			next = bins;
+		else {
+			next = (uint16_t)(cur * pow((double)bins / cur,
+				1.0 / (columns - c)) + 0.5);
+			if (next <= cur)
+				next = cur + 1;
+			if (next > bins)
+				next = bins;
+		}
+		edges[c + 1] = next;
+		cur = next;
+	}
+}
+
+void spectrumColumns(const int16_t mag[], const uint16_t edges[],
+	uint8_t columns, int16_t level[])
+{
+	uint16_t b, first, last;
+	int16_t  m;
+
+	for (uint8_t c = 0; c < columns; c++) {
+		first = edges[c];
+		last  = edges[c + 1];
+		if (last <= first) {	// Out of bins, repeat the top one
+			first = last - 1;
+		}
+		m = mag[first];
+		for (b = first + 1; b < last; b++) {
+			if (mag[b] > m)
+				m = mag[b];
+		}
+		level[c] = m;
+	}
+}
+
+void spectrumSpread(int16_t level[], uint8_t bands)
+{
+	// In place, from the right: column c only reads band <= c
+	for (uint8_t c = SPECTRUM_COLUMNS; c-- > 0; )
+		level[c] = level[c * bands / SPECTRUM_COLUMNS];
+}
+
+SpectrumHistory::SpectrumHistory(void)
+{
+	reset();
+}
+
+void SpectrumHistory::reset(void)
+{
+	pos    = 0;
+	filled = false;
+}
+
+void SpectrumHistory::add(const uint16_t samples[], uint8_t count)
+{
+	while (count--) {
+		ring[pos] = *samples++;
+		pos = (pos + 1) & (SPECTRUM_POINTS - 1);
+		if (pos == 0)
+			filled = true;
+	}
+}
+
+void SpectrumHistory::magnitudes(int16_t data[], uint8_t window)
+{
+	spectrumMagnitudes(ring, data, window, pos);
+}
+
+boolean SpectrumHistory::full(void)
+{
+	return filled;
+}
+
+SpectrumGoertzel::SpectrumGoertzel(void)
+{
+	bands = count = 0;
+}
+
+void SpectrumGoertzel::begin(uint8_t bands, uint16_t rate)
+{
+	uint16_t edges[SPECTRUM_GOERTZEL_MAX + 1];
+
+	if (bands > SPECTRUM_GOERTZEL_MAX)
+		bands = SPECTRUM_GOERTZEL_MAX;
+	this->bands = bands;
+	count       = 0;
+
+	spectrumLogMap(edges, bands, 1, SPECTRUM_POINTS / 2);
+	for (uint8_t b = 0; b < bands; b++) {
+		// Geometric center of the band's bins, in Hz
+		double bin = sqrt((double)edges[b] * (edges[b + 1] - 1));
+		fix_goertzel_init(&filters[b],
+			(uint16_t)(bin * rate / SPECTRUM_POINTS + 0.5), rate);
+	}
+}
+
+boolean SpectrumGoertzel::add(const uint16_t samples[], uint8_t n)
+{
+	count += n;
+	while (n--)
+		fix_goertzel(filters, bands, *samples++ - 2048);
+	return count >= SPECTRUM_POINTS;
+}
+
+void SpectrumGoertzel::levels(int16_t level[])
+{
+	// Magnitudes of 12 bit samples, to 8 bit units
+	for (uint8_t b = 0; b < bands; b++)
+		level[b] = fix_goertzel_mag(&filters[b], SPECTRUM_LOG2N) >> 4;
+	count = 0;
+}
+
+SpectrumLevels::SpectrumLevels(void)
+{
+	framesPerBlock = 1;
+	reset();
+}
+
+void SpectrumLevels::setHop(uint8_t hop)
+{
+	framesPerBlock = (hop && hop < SPECTRUM_POINTS) ? SPECTRUM_POINTS / hop : 1;
+	reset();
+}
+
+void SpectrumLevels::reset(void)
+{
+	for (uint8_t x=0; x<SPECTRUM_COLUMNS; x++) {
+		history[x].reset();
+		minLvlAvg[x] = 0;
+		maxLvlAvg[x] = 127;
+		heights[x]   = peaks[x] = 0;
+	}
+	dotCount = frameCount = 0;
+}
+
+void SpectrumLevels::update(const int16_t level[])
+{
+	int     lvl, minLvl, maxLvl, range;
+	int8_t  v;
+	boolean first = (frameCount == 0), last = false;
+
+	if (++frameCount >= framesPerBlock) {
+		frameCount = 0;
+		last       = true;
+	}
+
+	// Every third block, make the peak pixels drop by 1:
+	if (++dotCount >= 3 * framesPerBlock) {
+		dotCount = 0;
+		for (uint8_t x=0; x<SPECTRUM_COLUMNS; x++) {
+			if (peaks[x] > 0) peaks[x]--;
+		}
+	}
+
+	for (uint8_t x=0; x<SPECTRUM_COLUMNS; x++) {
+		v = level[x] > 127 ? 127 : level[x];
+		if (first || v > blockMax[x])
+			blockMax[x] = v;
+
+		if (last) {
+			history[x].push(blockMax[x]);
+
+			minLvl = history[x].lowest();      // Range of prior 10 blocks
+			maxLvl = history[x].highest();
+			// minLvl and maxLvl indicate the extents of the FFT output, used
+			// for vertically scaling the output graph (so it looks interesting
+			// regardless of volume level).  If they're too close together though
+			// (e.g. at very low volume levels) the graph becomes super coarse
+			// and 'jumpy'...so keep some minimum distance between them (this
+			// also lets the graph go to zero when no sound is playing):
+			if ((maxLvl - minLvl) < 8) maxLvl = minLvl + 8;
+			minLvlAvg[x] = (minLvlAvg[x] * 7 + minLvl) >> 3; // Dampen min/max levels
+			maxLvlAvg[x] = (maxLvlAvg[x] * 7 + maxLvl) >> 3; // (fake rolling average)
+		}
+
+		// Second fixed-point scale based on dynamic min/max levels:
+		range = maxLvlAvg[x] - minLvlAvg[x];
+		if (range < 8) range = 8;
+		lvl = ((level[x] - minLvlAvg[x]) * SPECTRUM_ROWS) / range;
+
+		// Clip output, allowing the dot to go a couple pixels off top
+		if (lvl < 0)                       heights[x] = 0;
+		else if (lvl > SPECTRUM_ROWS + 2)  heights[x] = SPECTRUM_ROWS + 2;
+		else                               heights[x] = lvl;
+
+		if (heights[x] > peaks[x]) peaks[x] = heights[x]; // Keep dot on top
+	}
+}
+
+uint8_t SpectrumLevels::height(uint8_t c)
+{
+	return heights[c];
+}
+
+uint8_t SpectrumLevels::peak(uint8_t c)
+{
+	return peaks[c];
+}
@@ -0,0 +1,168 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include "application.h"
+#include "RollingStats.h"
+#include "fix_fft.h"
+
+/*
+ The spectrum display pipeline, kept out of the sketch so the
+ same code can be run on recorded audio (tools/specreplay.cpp):
+
+   SpectrumHistory       ADC blocks -> last SPECTRUM_POINTS samples
+   spectrumMagnitudes()  samples -> window -> FFT -> |X[k]|
+   spectrumColumns()     bins -> display columns (spectrumLogMap())
+   SpectrumGoertzel      ADC blocks -> a few band levels, no FFT
+   SpectrumLevels        columns -> auto-gained heights and peaks
+
+ Equal-width groups of bins put nearly all of the music in the
+ leftmost columns, since each octave covers twice the bins of
+ the one below.  spectrumLogMap() instead spreads the bins over
+ the columns with logarithmic spacing (equal ratios, so roughly
+ equal musical intervals per column), once for a given panel
+ width; spectrumColumns() then applies it to each frame.
+*/
+
+#ifndef SPECTRUM_COLUMNS
+#define SPECTRUM_COLUMNS	32	// One per panel column; follow the panel width
+#endif
+#define SPECTRUM_ROWS		16	// Full scale column height
+#define SPECTRUM_POINTS		128	// Samples per block, 2 ** SPECTRUM_LOG2N
+#define SPECTRUM_LOG2N		7
+#define SPECTRUM_GOERTZEL_MAX	8	// Up to this many bands, Goertzel beats the FFT
+
+/*
+ spectrumMagnitudes() - window SPECTRUM_POINTS 12-bit ADC
+ samples (an AudioSampler block) with the given window.h
+ shape, transform them and leave the magnitudes of bins 1 ..
+ SPECTRUM_POINTS/2-1 in data[1 ..] (data[0], DC, is set to 0).
+ Magnitudes are in units of 1/N of an 8-bit sample, whatever
+ the window.  data[] must hold SPECTRUM_POINTS values.
+
+ samples[] can be a ring buffer of SPECTRUM_POINTS samples with
+ the oldest at 'start'; the unwrapping is part of the window
+ pass, so it costs nothing extra.
+*/
+void spectrumMagnitudes(const uint16_t samples[], int16_t data[],
+	uint8_t window, uint8_t start = 0);
+
+/*
+ The last SPECTRUM_POINTS samples, for overlapped analysis:
+ fed with blocks of 'hop' samples (a divisor of
+ SPECTRUM_POINTS, e.g. 32 or 64), it gives a new transform
+ every hop samples instead of every SPECTRUM_POINTS, at the
+ cost of one FFT per hop.  Sound then reaches the bars up to
+ SPECTRUM_POINTS - hop samples sooner.
+*/
+class SpectrumHistory {
+
+ public:
+
+	SpectrumHistory(void);
+
+	void
+		reset(void),
+		add(const uint16_t samples[], uint8_t count),
+		magnitudes(int16_t data[], uint8_t window);	// spectrumMagnitudes()
+	boolean
+		full(void);		// SPECTRUM_POINTS samples added since reset()?
+
+ private:
+
+	uint16_t ring[SPECTRUM_POINTS];
+	uint8_t  pos;		// Oldest sample, and where the next one goes
+	boolean  filled;
+};
+
+/*
+ spectrumLogMap() - fill edges[0 .. columns] so that column c
+ covers bins edges[c] .. edges[c+1]-1, spanning firstBin ..
+ bins-1 (bin 0 is DC, so firstBin is usually 1).  Every
+ column gets at least one bin; if there are more columns than
+ bins, the last columns repeat the top bin.
+*/
+void spectrumLogMap(uint16_t edges[], uint8_t columns, uint16_t firstBin,
+	uint16_t bins);
+
+/*
+ spectrumColumns() - level[c] = the largest magnitude among
+ the bins of column c, for c = 0 .. columns-1.
+*/
+void spectrumColumns(const int16_t mag[], const uint16_t edges[],
+	uint8_t columns, int16_t level[]);
+
+/*
+ spectrumSpread() - widen 'bands' levels in level[0 ..] to
+ fill all SPECTRUM_COLUMNS entries, each band repeated over
+ an equal share of the columns.  level[] must hold
+ SPECTRUM_COLUMNS values.
+*/
+void spectrumSpread(int16_t level[], uint8_t bands);
+
+/*
+ Band levels from Goertzel filters instead of a transform, for
+ faces with only a few bands (up to SPECTRUM_GOERTZEL_MAX).
+ Each band gets one filter, at the log spaced center of the
+ bins spectrumLogMap() would give it, so the bands sit where
+ the FFT path puts them; but each is only a bin wide, so a
+ tone between two bands shows in neither.  The cost is one
+ multiply per band per sample, paid as the samples arrive.
+
+ Feed it blocks whose size divides SPECTRUM_POINTS; add()
+ returns true once SPECTRUM_POINTS samples are in, then
+ levels() gives the band levels in spectrumColumns() units
+ and starts the next block.
+*/
+class SpectrumGoertzel {
+
+ public:
+
+	SpectrumGoertzel(void);
+
+	void
+		begin(uint8_t bands, uint16_t rate),
+		levels(int16_t level[]);
+	boolean
+		add(const uint16_t samples[], uint8_t n);
+
+ private:
+
+	goertzel_t filters[SPECTRUM_GOERTZEL_MAX];
+	uint8_t    bands, count;
+};
+
+/*
+ Column heights for SPECTRUM_COLUMNS columns of SPECTRUM_ROWS,
+ auto-gained so the graph looks lively at any volume: each
+ column is scaled between damped averages of its lowest and
+ highest level over the last 10 blocks.  Each column also has
+ a peak dot that falls one row every third block.
+
+ With overlapped frames, setHop() keeps those times the same:
+ the levels of the frames in a block are combined (the
+ loudest) before they go into the history.
+*/
+class SpectrumLevels {
+
+public:
+
+	SpectrumLevels(void);
+
+	void
+		reset(void),
+		setHop(uint8_t hop),            // New samples per frame, default SPECTRUM_POINTS
+		update(const int16_t level[]);  // One frame of spectrumColumns() output
+	uint8_t
+		height(uint8_t c),              // 0 - SPECTRUM_ROWS + 2
+		peak(uint8_t c);                // Height of the peak dot, 0 = none
+
+private:
+
+	RollingStats<int8_t, 10> history[SPECTRUM_COLUMNS];
+	int8_t  minLvlAvg[SPECTRUM_COLUMNS], maxLvlAvg[SPECTRUM_COLUMNS],
+	        blockMax[SPECTRUM_COLUMNS];	// Loudest level so far this block
+	uint8_t heights[SPECTRUM_COLUMNS], peaks[SPECTRUM_COLUMNS], dotCount,
+	        framesPerBlock, frameCount;
+};
+
+#endif
@@ -0,0 +1,162 @@
+/*
+analyzertest - AudioAnalyzer on a generated click track.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o analyzertest tools/analyzertest.cpp && ./analyzertest
+
+The analyzer runs on an AudioSampler set up as the sketch's (64 sample
+blocks at 8 kHz), fed through setSource() with quiet noise and a short
+decaying burst on every beat.  On the simulated clock, calling update()
+every 5 ms as a mode's frame loop would, each click track must give
+exactly one onset per click, bpm() must settle within BPM_ERROR of the
+track's tempo (folded into 75 - 150), and the sampler must see no
+overruns.  Ten seconds of loud steady noise must give at most one onset
+a second.
+
+The CPU budget is checked on the host's own clock: blocks are clocked
+into the sampler by hand, so they cost no time and the analysis is all
+the work there is.  With setBudget() at a few settings, load() must
+report close to the budget, not the whole CPU.  Host timings are not
+Core timings, but the share the limiter allows is the same on both.
+*/
+
+#include "application.h"
+#include "hosttimer.cpp"
+#include "../fixmath.cpp"
+#include "../fix_fft.cpp"
+#include "../spectrum.cpp"
+#include "../AudioSampler.cpp"
+#include "../AudioAnalyzer.cpp"
+
+#define MIC_RATE	8000		// As in the sketch
+#define BLOCK		64		// The sketch's SPECTRUM_HOP
+#define POLL_MS		5		// update() calls on the simulated clock
+#define CLICKS		20		// Per track
+#define LEAD_MS		500		// Before the first click
+#define CLICK_SAMPLES	160		// 20 ms burst
+#define BPM_ERROR	2
+#define BUDGET_MS	2500		// Host time per budget setting
+#define LOUD_MS		10000		// Simulated time of loud noise
+
+static int      failed;
+static uint32_t t;		// Next sample's index
+static uint32_t beat;		// Samples between clicks, 0 = noise only
+static double   noise;		// Of full scale
+
+static void check(bool ok, const char *what)
+{
+	if (!ok) {
+		printf("FAIL: %s\n", what);
+		failed = 1;
+	}
+}
+
+// Quiet noise, and on every beat a burst of louder noise that dies away
+static uint16_t clickSource(uint8_t)
+{
+	uint32_t lead = LEAD_MS * MIC_RATE / 1000, n = t++;
+	double   v = (rand() % 2001 - 1000) / 1000.0 * noise;
+
+	if (beat && n >= lead && (n - lead) / beat < CLICKS &&
+		(n - lead) % beat < CLICK_SAMPLES)
+		v += (rand() % 2001 - 1000) / 1250.0 *
+			exp(-4.0 * ((n - lead) % beat) / CLICK_SAMPLES);
+	return 2048 + (long)floor(v * 2047 + 0.5);
+}
+
+static void testTempo(AudioSampler &mic, AudioAnalyzer &audio, int bpm, int folded)
+{
+	long     onsets = 0, ms;
+	uint16_t found = 0;
+	char     what[80];
+
+	beat  = MIC_RATE * 60 / bpm;
+	noise = 1.0 / 64;
+	t     = 0;
+	srand(1);
+	audio.begin(MIC_RATE);
+	for (ms = 0; ms < LEAD_MS + (CLICKS * 60000L) / bpm; ms += POLL_MS) {
+		delay(POLL_MS);
+		audio.update();
+		onsets += audio.onset();
+		if (audio.bpm())
+			found = audio.bpm();
+	}
+	audio.end();
+
+	printf("%3d bpm: %ld onsets for %d clicks, bpm() %u, %u overruns\n",
+		bpm, onsets, CLICKS, found, mic.overruns());
+	snprintf(what, sizeof(what), "%d bpm: not one onset per click", bpm);
+	check(onsets == CLICKS, what);
+	snprintf(what, sizeof(what), "%d bpm: bpm() not within %d of %d", bpm, BPM_ERROR, folded);
+	check(abs((int)found - folded) <= BPM_ERROR, what);
+	snprintf(what, sizeof(what), "%d bpm: sampler overruns", bpm);
+	check(mic.overruns() == 0, what);
+}
+
+// Loud noise and no clicks: the flux and its average are high, but
+// steady, so there must be (next to) no onsets
+static void testLoudNoise(AudioAnalyzer &audio)
+{
+	long onsets = 0;
+
+	beat  = 0;
+	noise = 0.95;
+	t     = 0;
+	audio.begin(MIC_RATE);
+	for (long ms = 0; ms < LOUD_MS; ms += POLL_MS) {
+		delay(POLL_MS);
+		audio.update();
+		onsets += audio.onset();
+	}
+	audio.end();
+	printf("loud noise: %ld onsets in %.1f s\n", onsets, LOUD_MS / 1000.0);
+	check(onsets <= LOUD_MS / 1000, "onsets in loud steady noise");
+}
+
+// load() with blocks that cost nothing to deliver, so the analyzer
+// could use the whole CPU if the budget let it
+static void testBudget(AudioSampler &mic, AudioAnalyzer &audio, uint16_t permille)
+{
+	long     analysed = 0;
+	uint32_t start;
+	char     what[80];
+
+	beat  = 0;
+	noise = 1.0 / 64;
+	audio.begin(MIC_RATE);
+	audio.setBudget(permille);
+	start = micros();
+	while (micros() - start < BUDGET_MS * 1000UL) {
+		for (int i = 0; i < BLOCK; i++)
+			mic.sample();
+		analysed += audio.update();
+	}
+	audio.end();
+
+	printf("budget %4u per mille: load() %4u, %ld analyses in %.1f s\n",
+		permille, audio.load(), analysed, BUDGET_MS / 1000.0);
+	snprintf(what, sizeof(what), "load() %u with a budget of %u", audio.load(), permille);
+	check(audio.load() >= permille * 3 / 4 && audio.load() <= permille * 5 / 4, what);
+}
+
+int main(void)
+{
+	AudioSampler  mic(A0, BLOCK);
+	AudioAnalyzer audio(mic);
+
+	mic.setSource(clickSource);
+	testTempo(mic, audio, 120, 120);
+	testTempo(mic, audio, 90, 90);
+	testTempo(mic, audio, 200, 100);
+	testLoudNoise(audio);
+
+	testBudget(mic, audio, 50);
+	testBudget(mic, audio, 100);
+	testBudget(mic, audio, 400);
+	if (!failed)
+		printf("all checks passed\n");
+	return failed;
+}
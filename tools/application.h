@@ -0,0 +1,318 @@
+/*
+Host stand-in for the Particle firmware header, just enough of the
+Wiring and cloud API for the host tools in this directory to compile
+the library sources (fonts, fix_fft, fixmath, spectrum, Plasma,
+RGBmatrixPanel, AudioSampler ...) and the sketch itself (see sketch.h).
+
+It poses as a Photon.  Pins, the cloud and Serial do nothing.
+
+Time: micros() and millis() follow the host clock, plus the time every
+delay() so far would have taken.  delay() doesn't sleep; it moves the
+clock on at once and runs the IntervalTimer interrupts that would have
+come in the meantime (see hosttimer.cpp, which the tools build instead
+of SparkIntervalTimer.cpp).  So a swapBuffers() that waits for the
+refresh interrupt still returns, and a mode's delay(50) between frames
+costs no host time.  hostBusyMicros() is the host time spent outside
+delay(), i.e. what the code itself used.
+
+Everything is defined here: the tools are single translation units.
+*/
+
+#ifndef _TOOLS_APPLICATION_H
+#define _TOOLS_APPLICATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <chrono>
+#include <string>
+
+// glibc's gamma() would clash with RGBmatrixPanel.cpp's gamma table
+#define gamma	hostGammaTable
+
+#ifndef PLATFORM_ID
+#define PLATFORM_ID	6		// Photon
+#define STM32F2XX
+#endif
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define pgm_read_byte(addr)	(*(const uint8_t *)(addr))
+#define F(s)	s
+
+enum { DEC = 10, HEX = 16 };
+enum { INPUT, OUTPUT };
+enum { D0, D1, D2, D3, D4, D5, D6, D7, A0, A1, A2, A3, A4, A5, A6, A7 };
+
+inline void pinMode(int, int) { }
+inline void pinSetFast(int) { }
+inline void pinResetFast(int) { }
+inline void digitalWrite(int, int) { }
+inline int  analogRead(int) { return 2048; }	// A quiet microphone
+inline void noInterrupts(void) { }
+inline void interrupts(void) { }
+
+inline long random(long max) { return max > 0 ? rand() % max : 0; }
+inline long random(long min, long max) { return min + random(max - min); }
+inline void randomSeed(unsigned int seed) { srand(seed); }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+	return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// Any radix 2 - 36, a sign only in base 10, like the firmware's
+inline char *itoa(int value, char *buffer, unsigned char radix)
+{
+	char     digits[32], *p = buffer;
+	int      n = 0;
+	unsigned u = (radix == 10 && value < 0) ? 0U - value : (unsigned)value;
+
+	if (radix < 2 || radix > 36)
+		radix = 10;
+	do {
+		digits[n++] = "0123456789abcdefghijklmnopqrstuvwxyz"[u % radix];
+		u /= radix;
+	} while (u);
+	if (radix == 10 && value < 0)
+		*p++ = '-';
+	while (n)
+		*p++ = digits[--n];
+	*p = 0;
+	return buffer;
+}
+
+// ---- Time and the simulated timer interrupts ----
+
+struct HostTimer {
+	void   (*isr)(void);	// NULL = slot free
+	uint32_t period;	// us
+	uint64_t next;		// micros() it fires at
+};
+#define HOST_TIMERS	5
+
+struct HostClock {
+	std::chrono::steady_clock::time_point start;
+	uint64_t  skipped;	// us delay() has moved the clock on
+	double    inDelay;	// Host seconds spent inside delay()
+	HostTimer timers[HOST_TIMERS];
+
+	HostClock(void) : start(std::chrono::steady_clock::now()), skipped(0),
+		inDelay(0) { memset(timers, 0, sizeof(timers)); }
+};
+
+inline HostClock &hostClock(void)
+{
+	static HostClock clock;
+	return clock;
+}
+
+inline double hostSeconds(void)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+		hostClock().start).count();
+}
+
+inline uint64_t hostMicros(void)
+{
+	return (uint64_t)(hostSeconds() * 1e6) + hostClock().skipped;
+}
+
+inline unsigned long micros(void) { return (unsigned long)hostMicros(); }
+inline unsigned long millis(void) { return (unsigned long)(hostMicros() / 1000); }
+
+// Host time used so far outside delay()
+inline uint64_t hostBusyMicros(void)
+{
+	return (uint64_t)((hostSeconds() - hostClock().inDelay) * 1e6);
+}
+
+// Move the clock on by 'us', running due timer interrupts in order
+inline void delayMicroseconds(unsigned int us)
+{
+	HostClock &c = hostClock();
+	double    entered = hostSeconds();
+	uint64_t  now = hostMicros(), end = now + us;
+
+	for (int i = 0; i < HOST_TIMERS; i++)	// Nothing fires in the past
+		if (c.timers[i].isr && c.timers[i].next < now)
+			c.timers[i].next = now + c.timers[i].period;
+	for (;;) {
+		HostTimer *t = NULL;
+		for (int i = 0; i < HOST_TIMERS; i++)
+			if (c.timers[i].isr && c.timers[i].next <= end &&
+				(!t || c.timers[i].next < t->next))
+				t = &c.timers[i];
+		if (!t)
+			break;
+		t->next += t->period;	// Before the ISR, which may change it
+		t->isr();
+	}
+	c.skipped += us;
+	c.inDelay += hostSeconds() - entered;
+}
+
+inline void delay(unsigned long ms)
+{
+	while (ms--)
+		delayMicroseconds(1000);
+}
+
+// ---- Print, String, Serial ----
+
+class Print {
+ public:
+	virtual ~Print(void) { }
+	virtual size_t write(uint8_t) = 0;
+	size_t print(const char *s)
+	{
+		size_t n = 0;
+		while (*s)
+			n += write(*s++);
+		return n;
+	}
+	size_t print(char c) { return write(c); }
+	size_t print(long v, int base = DEC)
+	{
+		char buf[24];
+		snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%ld", v);
+		return print(buf);
+	}
+	size_t print(int v, int base = DEC) { return print((long)v, base); }
+	size_t println(const char *s) { return print(s) + print("\n"); }
+};
+
+class String {
+ public:
+	String(void) { }
+	String(const char *s) : s(s) { }
+	String &operator=(const char *c) { s = c; return *this; }
+	bool operator==(const char *c) const { return s == c; }
+	bool operator==(const String &o) const { return s == o.s; }
+	unsigned int length(void) const { return s.size(); }
+	const char *c_str(void) const { return s.c_str(); }
+	int indexOf(char c, unsigned int from = 0) const
+	{
+		size_t p = s.find(c, from);
+		return p == std::string::npos ? -1 : (int)p;
+	}
+	String substring(unsigned int from) const { return String(s.substr(from).c_str()); }
+	String substring(unsigned int from, unsigned int to) const
+	{
+		return String(s.substr(from, to - from).c_str());
+	}
+	long toInt(void) const { return atol(s.c_str()); }
+	void toUpperCase(void)
+	{
+		for (size_t i = 0; i < s.size(); i++)
+			s[i] = toupper(s[i]);
+	}
+	void toCharArray(char *buf, unsigned int size) const { getBytes((unsigned char *)buf, size); }
+	void getBytes(unsigned char *buf, unsigned int size, unsigned int index = 0) const
+	{
+		if (!size)
+			return;
+		size_t n = index < s.size() ? s.size() - index : 0;
+		if (n > size - 1)
+			n = size - 1;
+		memcpy(buf, s.c_str() + (index < s.size() ? index : 0), n);
+		buf[n] = 0;
+	}
+ private:
+	std::string s;
+};
+
+struct HostSerial {
+	void begin(long) { }
+	template<class T> void print(T) { }
+	template<class T> void print(T, int) { }
+	template<class T> void println(T) { }
+	void write(char) { }
+};
+static HostSerial Serial __attribute__((unused));
+
+// ---- Cloud, system and time of day ----
+
+enum { STRING, INT, DOUBLE };
+enum { PUBLIC, PRIVATE, MY_DEVICES, ALL_DEVICES };
+#define SYSTEM_THREAD(x)
+#define SYSTEM_MODE(x)
+
+// process() counts its calls: the clock faces make one a frame
+struct HostSpark {
+	unsigned long processed;
+
+	HostSpark(void) : processed(0) { }
+	void connect(void) { }
+	bool connected(void) { return true; }
+	void process(void) { processed++; }
+	void syncTime(void) { }
+	bool publish(const char *, const char *, int, int) { return true; }
+	template<class T> bool variable(const char *, T, int) { return true; }
+	bool function(const char *, int (*)(String)) { return true; }
+	bool subscribe(const char *, void (*)(const char *, const char *), int) { return true; }
+};
+static HostSpark Spark;
+
+struct HostSystem {
+	void reset(void) { }
+};
+static HostSystem System __attribute__((unused));
+
+// The clock starts at HOST_EPOCH (a Wednesday, 12:34 UTC) and runs with
+// millis()
+#define HOST_EPOCH	1500035640L
+
+struct HostTime {
+	long offset;	// Time zone, seconds
+
+	HostTime(void) : offset(0) { }
+	void zone(float hours) { offset = (long)(hours * 3600); }
+	int now(void) { return HOST_EPOCH + millis() / 1000; }
+	struct tm at(long t)
+	{
+		time_t local = t + offset;
+		struct tm tm;
+		gmtime_r(&local, &tm);
+		return tm;
+	}
+	int second(long t)  { return at(t).tm_sec; }
+	int minute(long t)  { return at(t).tm_min; }
+	int hour(long t)    { return at(t).tm_hour; }
+	int day(long t)     { return at(t).tm_mday; }
+	int weekday(long t) { return at(t).tm_wday + 1; }
+	int month(long t)   { return at(t).tm_mon + 1; }
+	int year(long t)    { return at(t).tm_year + 1900; }
+	int second(void)  { return second(now()); }
+	int minute(void)  { return minute(now()); }
+	int hour(void)    { return hour(now()); }
+	int day(void)     { return day(now()); }
+	int weekday(void) { return weekday(now()); }
+	int month(void)   { return month(now()); }
+	int year(void)    { return year(now()); }
+	String timeStr(void)
+	{
+		struct tm tm = at(now());
+		char buf[32];
+		strftime(buf, sizeof(buf), "%a %b %e %H:%M:%S %Y", &tm);
+		return String(buf);
+	}
+};
+static HostTime Time;
+
+// ---- Interrupt attachment, as used by SparkIntervalTimer.h ----
+
+enum {
+	SysInterrupt_TIM3_Update, SysInterrupt_TIM4_Update,
+	SysInterrupt_TIM5_Update, SysInterrupt_TIM6_Update,
+	SysInterrupt_TIM7_Update
+};
+inline bool attachSystemInterrupt(int, void (*)(void)) { return true; }
+
+#endif
@@ -0,0 +1,202 @@
+/*
+blendtest - RGBmatrixPanel's whole-buffer operations (fadeBuffer(),
+blendBuffers(), addBuffer()) against per-pixel reference math.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o blendtest tools/blendtest.cpp && ./blendtest
+
+Random frames are drawn pixel by pixel with drawPixel(), and each
+operation's result is read back channel by channel and compared with
+the same operation done in floating point on the colors that were
+drawn:
+
+	fadeBuffer(a, level)        a * level / 255
+	blendBuffers(a, b, alpha)   a + (b - a) * alpha / 255, rounded
+	addBuffer(a) onto b         a + b, at most 15
+
+Fades and blends may be one step of 15 off the real value in between,
+but must be exact at both ends (level or alpha 0 and 255); sums must be
+exact.  A source may also be the back buffer the result goes to.  The
+steps of the sketch's crossFade() (alpha 80 seven times, then 255) must
+land exactly on the new frame, and fadeOut()'s 15 steps at level 176
+must reach black.  Last, crossFade() itself must leave the new frame on
+the panel and in the back buffer, in direct color and in indexed mode
+with an overlay, where the frame it fades to is the composed one.
+*/
+
+#include "sketch.h"
+
+#define FRAMES		50		// Random frame pairs per operation
+
+static int    failed;
+static int    width, height;
+static size_t size;
+
+// Channel c (0 = R, 1 = G, 2 = B) of pixel (x, y) in packed planes
+static uint8_t channel(const uint8_t *planes, int x, int y, int c)
+{
+	uint8_t ch[6];
+	int     rows = height / 2;
+
+	unpackPlanes(&planes[(y % rows) * width * 3 + x], width, ch);
+	return ch[(y >= rows ? 3 : 0) + c];
+}
+
+// A random frame, drawn pixel by pixel; rgb[] gets its channels
+static void randomFrame(uint8_t *planes, uint8_t *rgb)
+{
+	for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++) {
+			uint8_t *p = &rgb[(y * width + x) * 3];
+			p[0] = random(0, 16);
+			p[1] = random(0, 16);
+			p[2] = random(0, 16);
+			// The extremes often, they are where rounding goes wrong
+			for (int c = 0; c < 3; c++)
+				if (!random(0, 4))
+					p[c] = random(0, 2) ? 15 : 0;
+			matrix.drawPixel(x, y, RGBmatrixPanel::RGB444(p[0], p[1], p[2]));
+		}
+	memcpy(planes, matrix.backBuffer(), size);
+}
+
+// Compares the back buffer with reference channels; returns the largest
+// difference
+static int compare(const uint8_t *ref)
+{
+	int worst = 0;
+
+	for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+			for (int c = 0; c < 3; c++) {
+				int d = abs(channel(matrix.backBuffer(), x, y, c) - ref[(y * width + x) * 3 + c]);
+				if (d > worst)
+					worst = d;
+			}
+	return worst;
+}
+
+static void check(bool ok, const char *what, int arg)
+{
+	if (!ok) {
+		printf("FAIL: %s %d\n", what, arg);
+		failed = 1;
+	}
+}
+
+int main(void)
+{
+	sketchInit();
+	width  = matrix.width();
+	height = matrix.height();
+	size   = width * height / 2 * 3;
+
+	int      n = width * height * 3;
+	uint8_t *a = new uint8_t[size], *b = new uint8_t[size];
+	uint8_t *ra = new uint8_t[n], *rb = new uint8_t[n], *ref = new uint8_t[n];
+	int      worstFade = 0, worstBlend = 0, worstAdd = 0;
+
+	srand(1);
+	// Reading back what drawPixel() wrote must give the colors drawn
+	randomFrame(a, ra);
+	check(compare(ra) == 0, "planes read back differ from the pixels drawn, frame", 0);
+
+	for (int f = 0; f < FRAMES; f++) {
+		randomFrame(a, ra);
+		randomFrame(b, rb);
+
+		for (int level = 0; level < 256; level++) {
+			for (int i = 0; i < n; i++)
+				ref[i] = (int)(ra[i] * level / 255.0);
+			matrix.fadeBuffer(a, level);
+			int d = compare(ref);
+			if (d > worstFade)
+				worstFade = d;
+			check(d <= ((level == 0 || level == 255) ? 0 : 1), "fadeBuffer() level", level);
+		}
+
+		for (int alpha = 0; alpha < 256; alpha++) {
+			for (int i = 0; i < n; i++)
+				ref[i] = floor(ra[i] + (rb[i] - ra[i]) * alpha / 255.0 + 0.5);
+			matrix.blendBuffers(a, b, alpha);
+			int d = compare(ref);
+			if (d > worstBlend)
+				worstBlend = d;
+			check(d <= ((alpha == 0 || alpha == 255) ? 0 : 1), "blendBuffers() alpha", alpha);
+			// The back buffer as the first source
+			memcpy(matrix.backBuffer(), a, size);
+			matrix.blendBuffers(matrix.backBuffer(), b, alpha);
+			check(compare(ref) == d, "blendBuffers() from the back buffer, alpha", alpha);
+		}
+
+		for (int i = 0; i < n; i++)
+			ref[i] = ra[i] + rb[i] > 15 ? 15 : ra[i] + rb[i];
+		memcpy(matrix.backBuffer(), b, size);
+		matrix.addBuffer(a);
+		int d = compare(ref);
+		if (d > worstAdd)
+			worstAdd = d;
+		check(d == 0, "addBuffer(), frame", f);
+
+		// crossFade(): the steps go from a towards b, the last lands on b
+		memcpy(matrix.backBuffer(), a, size);
+		for (int step = 0; step < 8; step++)
+			matrix.blendBuffers(matrix.backBuffer(), b, step < 7 ? 80 : 255);
+		check(memcmp(matrix.backBuffer(), b, size) == 0, "cross-fade does not end on the new frame", f);
+
+		// fadeOut(): level 176 from the front buffer, 15 times
+		memcpy(matrix.backBuffer(), a, size);
+		for (int step = 0; step < 15; step++)
+			matrix.fadeBuffer(matrix.backBuffer(), 176);
+		memset(ref, 0, n);
+		check(compare(ref) == 0, "fade out not black after 15 steps, frame", f);
+	}
+
+	// crossFade() from a to b, drawn directly
+	uint8_t row[64];
+	randomFrame(a, ra);
+	matrix.swapBuffers(true);
+	randomFrame(b, rb);
+	crossFade();
+	check(memcmp(matrix.frontBuffer(), b, size) == 0 && memcmp(matrix.backBuffer(), b, size) == 0,
+		"crossFade() does not end on the new frame, direct", 0);
+
+	// ... and to a frame of indices with the clock overlay on top
+	GFXcanvas444 overlay(16, 7);
+	overlay.setTransparent(0);
+	overlay.fillScreen(0);
+	overlay.drawRect(0, 0, 16, 7, matrix.Color444(15, 0, 0));
+	matrix.setOverlay(&overlay, 8, 4);
+	if (matrix.setIndexed(true)) {
+		for (int i = 0; i < 256; i++)
+			matrix.setPaletteColor(i, matrix.ColorHSV(i * 6, 255, 255, true));
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++)
+				row[x] = x * 8 + y;
+			matrix.drawIndexRow(y, row);
+		}
+		matrix.composeFrame();
+		memcpy(b, matrix.backBuffer(), size);
+		crossFade();
+		check(memcmp(matrix.frontBuffer(), b, size) == 0 && memcmp(matrix.backBuffer(), b, size) == 0,
+			"crossFade() does not end on the new frame, indexed", 1);
+		matrix.setIndexed(false);
+	}
+	matrix.setOverlay(NULL);
+
+	printf("%d frame pairs of %dx%d: largest difference from the reference, of 15\n",
+		FRAMES, width, height);
+	printf("  fadeBuffer()    %d\n  blendBuffers()  %d\n  addBuffer()     %d\n",
+		worstFade, worstBlend, worstAdd);
+	if (!failed)
+		printf("all checks passed\n");
+
+	delete[] a;
+	delete[] b;
+	delete[] ra;
+	delete[] rb;
+	delete[] ref;
+	return failed;
+}
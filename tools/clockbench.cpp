@@ -0,0 +1,176 @@
+/*
+clockbench - frames per second of the normal clock face, and what
+vectorNumber()'s integer end points save on each of them.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o clockbench tools/clockbench.cpp && ./clockbench
+
+It builds the sketch with tools/sketch.h and runs normal_clock() for a
+while.  normal_clock() draws as fast as it can, one frame per
+Spark.process(); the frames per second reported count only the host
+time spent drawing, not the waits for the panel refresh at each swap
+(see tools/application.h), i.e. the rate the CPU alone would allow.
+
+Then every digit is drawn by vectorNumber() and by the float version
+it replaced (kept here), at the scales the sketch uses and one with
+halves along both axes, at every position around and partly off a
+canvas and the panel; both must set the same pixels.  Last the 16
+digits of one normal_clock() frame are timed both ways.  A PC has the
+floating point unit the Core lacks, so the float math saved is cheap
+here and the host ratio is close to 1; on the Core each float end point
+is a soft-float add, often a multiply, and a conversion.
+*/
+
+#include "sketch.h"
+
+#define SECONDS		20		// Of normal_clock() to run
+#define ROUNDS		20000		// Frames of digits per timing run
+
+// Digit, x, y of each vectorNumber() call of one normal_clock() frame
+// (the digits for 12:34, nothing scrolling)
+static const int8_t digits[16][3] = {
+	{ 1,  2,  2 }, { 2,  9,  2 }, { 1,  2,  2 }, { 2,  9,  2 },
+	{ 1,  1,  1 }, { 2,  8,  1 }, { 1,  1,  1 }, { 2,  8,  1 },
+	{ 3, 19,  2 }, { 4, 26,  2 }, { 3, 19,  2 }, { 4, 26,  2 },
+	{ 3, 18,  1 }, { 4, 25,  1 }, { 3, 18,  1 }, { 4, 25,  1 },
+};
+
+// vectorNumber() as it was, every end point in float
+static void floatDigit(int n, int x, int y, int color, float scale_x, float scale_y, Adafruit_GFX &gfx){
+
+	switch (n){
+	case 0:
+		gfx.drawLine(x ,y , x , y+(4*scale_y) , color);
+		gfx.drawLine(x , y+(4*scale_y) , x+(2*scale_x) , y+(4*scale_y), color);
+		gfx.drawLine(x+(2*scale_x) , y , x+(2*scale_x) , y+(4*scale_y) , color);
+		gfx.drawLine(x ,y , x+(2*scale_x) , y , color);
+		break; 
+	case 1: 
+		gfx.drawLine( x+(1*scale_x), y, x+(1*scale_x),y+(4*scale_y), color);  
+		gfx.drawLine(x , y+4*scale_y , x+2*scale_x , y+4*scale_y,color);
+		gfx.drawLine(x,y+scale_y, x+scale_x, y,color);
+		break;
+	case 2:
+		gfx.drawLine(x ,y , x+2*scale_x , y , color);
+		gfx.drawLine(x+2*scale_x , y , x+2*scale_x , y+2*scale_y , color);
+		gfx.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
+		gfx.drawLine(x , y+2*scale_y, x , y+4*scale_y,color);
+		gfx.drawLine(x , y+4*scale_y , x+2*scale_x , y+4*scale_y,color);
+		break; 
+	case 3:
+		gfx.drawLine(x ,y , x+2*scale_x , y , color);
+		gfx.drawLine(x+2*scale_x , y , x+2*scale_x , y+4*scale_y , color);
+		gfx.drawLine(x+2*scale_x , y+2*scale_y , x+scale_x , y+2*scale_y, color);
+		gfx.drawLine(x , y+4*scale_y , x+2*scale_x , y+4*scale_y,color);
+		break;
+	case 4:
+		gfx.drawLine(x+2*scale_x , y , x+2*scale_x , y+4*scale_y , color);
+		gfx.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
+		gfx.drawLine(x ,y , x , y+2*scale_y , color);
+		break;
+	case 5:
+		gfx.drawLine(x ,y , x+2*scale_x , y , color);
+		gfx.drawLine(x , y , x , y+2*scale_y , color);
+		gfx.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
+		gfx.drawLine(x+2*scale_x , y+2*scale_y, x+2*scale_x , y+4*scale_y,color);
+		gfx.drawLine( x , y+4*scale_y , x+2*scale_x , y+4*scale_y,color);
+		break; 
+	case 6:
+		gfx.drawLine(x ,y , x , y+(4*scale_y) , color);
+		gfx.drawLine(x ,y , x+2*scale_x , y , color);
+		gfx.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
+		gfx.drawLine(x+2*scale_x , y+2*scale_y, x+2*scale_x , y+4*scale_y,color);
+		gfx.drawLine(x+2*scale_x , y+4*scale_y , x, y+(4*scale_y) , color);
+		break;
+	case 7:
+		gfx.drawLine(x ,y , x+2*scale_x , y , color);
+		gfx.drawLine( x+2*scale_x, y, x+scale_x,y+(4*scale_y), color);
+		break;
+	case 8:
+		gfx.drawLine(x ,y , x , y+(4*scale_y) , color);
+		gfx.drawLine(x , y+(4*scale_y) , x+(2*scale_x) , y+(4*scale_y), color);
+		gfx.drawLine(x+(2*scale_x) , y , x+(2*scale_x) , y+(4*scale_y) , color);
+		gfx.drawLine(x ,y , x+(2*scale_x) , y , color);
+		gfx.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
+		break;
+	case 9:
+		gfx.drawLine(x ,y , x , y+(2*scale_y) , color);
+		gfx.drawLine(x , y+(4*scale_y) , x+(2*scale_x) , y+(4*scale_y), color);
+		gfx.drawLine(x+(2*scale_x) , y , x+(2*scale_x) , y+(4*scale_y) , color);
+		gfx.drawLine(x ,y , x+(2*scale_x) , y , color);
+		gfx.drawLine(x+2*scale_x , y+2*scale_y , x , y+2*scale_y, color);
+		break;    
+	}
+}
+
+
+static double seconds(std::chrono::steady_clock::time_point t0)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	sketchInit();
+
+	unsigned long frames = Spark.processed;
+	uint64_t      busy = hostBusyMicros();
+	showClock = SECONDS;
+	normal_clock();
+	frames = Spark.processed - frames;
+	printf("normal_clock(): %lu frames, %.0f frames per second of CPU\n\n",
+		frames, frames * 1e6 / (hostBusyMicros() - busy));
+
+	// Every digit at each scale and position, both ways
+	static const float scales[][2] = { { 2.5, 3.0 }, { 1, 1 }, { 1.5, 2.5 } };
+	size_t     planes = matrix.width() * matrix.height() / 2 * 3;
+	uint8_t   *lines = new uint8_t[planes];
+	GFXcanvas1 before(32, 16), after(32, 16);
+	long       wrong = 0, drawn = 0;
+	for (size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); s++)
+		for (int n = 0; n <= 9; n++)
+			for (int y = -16; y <= 16; y++)
+				for (int x = -8; x <= 32; x++) {
+					float sx = scales[s][0], sy = scales[s][1];
+					before.fillScreen(0);
+					after.fillScreen(0);
+					floatDigit(n, x, y, 1, sx, sy, before);
+					vectorNumber(n, x, y, 1, sx, sy, after);
+					wrong += memcmp(before.getBuffer(), after.getBuffer(), 32 / 8 * 16) != 0;
+
+					matrix.fillScreen(0);
+					floatDigit(n, x, y, White, sx, sy, matrix);
+					memcpy(lines, matrix.backBuffer(), planes);
+					matrix.fillScreen(0);
+					vectorNumber(n, x, y, White, sx, sy);
+					wrong += memcmp(lines, matrix.backBuffer(), planes) != 0;
+					drawn += 2;
+				}
+	delete[] lines;
+	printf("%ld of %ld digits differ from the float version\n\n", wrong, drawn);
+	if (wrong)
+		failed = 1;
+
+	uint16_t color = matrix.Color444(1, 1, 1);
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	for (long r = 0; r < ROUNDS; r++)
+		for (int d = 0; d < 16; d++)
+			floatDigit(digits[d][0], digits[d][1], digits[d][2], color, 2.5, 3.0, matrix);
+	double tFloat = seconds(t0);
+
+	t0 = std::chrono::steady_clock::now();
+	for (long r = 0; r < ROUNDS; r++)
+		for (int d = 0; d < 16; d++)
+			vectorNumber(digits[d][0], digits[d][1], digits[d][2], color, 2.5, 3.0);
+	double tInt = seconds(t0);
+
+	printf("%-28s  %12s\n", "16 digits of a frame", "ns/frame");
+	printf("%-28s  %12.0f\n", "float end points", tFloat * 1e9 / ROUNDS);
+	printf("%-28s  %12.0f  (%.1fx)\n", "vectorNumber()", tInt * 1e9 / ROUNDS,
+		tFloat / tInt);
+	return failed;
+}
@@ -0,0 +1,147 @@
+/*
+colorbench - text and lines drawn with rgb444_t colors against the
+5/6/5 ones Adafruit_GFX passes around.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o colorbench tools/colorbench.cpp && ./colorbench
+
+The same text and lines, some of them partly off the panel, are drawn
+three ways: through the generic Adafruit_GFX code with a 5/6/5 color,
+converted at every pixel (how the panel drew before rgb444_t); through
+the panel's 5/6/5 calls, which now convert once per call; and with an
+rgb444_t from RGBmatrixPanel::RGB444().  All three must leave the same
+bytes in the bit planes.  Host timings; only the ratios carry over to
+the Core.
+*/
+
+#include "sketch.h"
+
+#define ROUNDS		20000		// Of each workload per timing run
+#define TIMINGS		5		// Runs, the fastest is reported
+#define LINES		64
+
+static const char text[] = "12:34 WED";
+
+struct Line { int16_t x0, y0, x1, y1; uint16_t c; };
+static Line lines[LINES];
+
+// One screen of text and one of lines, each way
+static void textGFX(void)
+{
+	for (int i = 0; text[i]; i++) {
+		matrix.Adafruit_GFX::drawChar(i * 4 - 2, 1, text[i], Green, Green, 1);
+		matrix.Adafruit_GFX::drawChar(i * 4 - 3, 9, text[i], Navy, Black, 1);
+	}
+}
+
+static void text565(void)
+{
+	for (int i = 0; text[i]; i++) {
+		matrix.drawFastChar(i * 4 - 2, 1, text[i], Green, Green, 1);
+		matrix.drawFastChar(i * 4 - 3, 9, text[i], Navy, Black, 1);
+	}
+}
+
+static void text444(void)
+{
+	rgb444_t green = RGBmatrixPanel::RGB444(Green), navy = RGBmatrixPanel::RGB444(Navy),
+	         black = RGBmatrixPanel::RGB444(Black);
+	for (int i = 0; text[i]; i++) {
+		matrix.drawChar(i * 4 - 2, 1, text[i], green, green, 1);
+		matrix.drawChar(i * 4 - 3, 9, text[i], navy, black, 1);
+	}
+}
+
+static void linesGFX(void)
+{
+	for (int i = 0; i < LINES; i++)
+		matrix.Adafruit_GFX::drawLine(lines[i].x0, lines[i].y0, lines[i].x1, lines[i].y1, lines[i].c);
+}
+
+static void lines565(void)
+{
+	for (int i = 0; i < LINES; i++)
+		matrix.drawLine(lines[i].x0, lines[i].y0, lines[i].x1, lines[i].y1, lines[i].c);
+}
+
+static void lines444(void)
+{
+	for (int i = 0; i < LINES; i++)
+		matrix.drawLine(lines[i].x0, lines[i].y0, lines[i].x1, lines[i].y1,
+			RGBmatrixPanel::RGB444(lines[i].c));
+}
+
+static double seconds(std::chrono::steady_clock::time_point t0)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Draws once into a cleared back buffer and keeps the result, then
+// returns ns per call, the best of TIMINGS runs of ROUNDS calls
+static double run(void (*draw)(void), uint8_t *planes, size_t size)
+{
+	double best = 0;
+
+	matrix.fillScreen(0);
+	draw();
+	memcpy(planes, matrix.backBuffer(), size);
+
+	for (int t = 0; t < TIMINGS; t++) {
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		for (long r = 0; r < ROUNDS; r++)
+			draw();
+		double s = seconds(t0);
+		if (!t || s < best)
+			best = s;
+	}
+	return best * 1e9 / ROUNDS;
+}
+
+int main(void)
+{
+	static const struct {
+		const char *name;
+		void (*draw[3])(void);
+	} workloads[] = {
+		{ "text, 18 glyphs",  { textGFX,  text565,  text444  } },
+		{ "lines, 64",        { linesGFX, lines565, lines444 } },
+	};
+	int    failed = 0;
+	size_t size;
+
+	sketchInit();
+	size = matrix.width() * matrix.height() / 2 * 3;
+
+	srand(1);
+	for (int i = 0; i < LINES; i++) {
+		lines[i].x0 = random(-8, matrix.width() + 8);
+		lines[i].y0 = random(-8, matrix.height() + 8);
+		lines[i].x1 = random(-8, matrix.width() + 8);
+		lines[i].y1 = random(-8, matrix.height() + 8);
+		lines[i].c  = random(0, 65536);
+	}
+
+	printf("%-20s  %14s  %14s  %14s\n", "", "GFX 5/6/5", "panel 5/6/5", "rgb444_t");
+	for (size_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++) {
+		uint8_t *planes[3];
+		double   ns[3];
+
+		for (int i = 0; i < 3; i++) {
+			planes[i] = new uint8_t[size];
+			ns[i] = run(workloads[w].draw[i], planes[i], size);
+		}
+		printf("%-20s  %11.0f ns  %11.0f ns  %11.0f ns  (%.1fx)\n", workloads[w].name,
+			ns[0], ns[1], ns[2], ns[0] / ns[2]);
+		for (int i = 1; i < 3; i++)
+			if (memcmp(planes[0], planes[i], size)) {
+				printf("%s: the %s planes differ from Adafruit_GFX's\n",
+					workloads[w].name, i == 1 ? "5/6/5" : "rgb444_t");
+				failed = 1;
+			}
+		for (int i = 0; i < 3; i++)
+			delete[] planes[i];
+	}
+	return failed;
+}
@@ -0,0 +1,159 @@
+/*
+fftbench - accuracy and speed of the fix_fft() / fix_fftr() variants
+(8-bit and 16-bit, complex and real input) at every size they support.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o fftbench tools/fftbench.cpp && ./fftbench
+
+Each transform is fed a two-tone test signal plus a little noise, at a
+loud level (-1 dBFS) and a quiet one (-40 dBFS), and its output is
+compared with a double precision DFT of the same quantized samples.
+Accuracy is reported as the signal to error ratio over bins 0 .. N/2.
+Timings are host timings; only the ratios between variants carry over
+to the Core.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+
+#include "../fixmath.cpp"
+#include "../fix_fft.cpp"
+
+#define TRIALS		20
+#define BENCH_POINTS	(1L << 18)	// Points transformed per timing run
+
+enum { COMPLEX8, REAL8, COMPLEX16, REAL16, NUM_VARIANTS };
+
+static const char *variantNames[NUM_VARIANTS] = {
+	"fix_fft 8-bit", "fix_fftr 8-bit", "fix_fft 16-bit", "fix_fftr 16-bit"
+};
+
+// Run one variant on x[] (full scale = 1.0), spectrum bins 0 .. N/2 in
+// input units go to re[], im[]
+static void transform(int v, int m, const std::vector<double> &x,
+	std::vector<double> &re, std::vector<double> &im,
+	std::vector<double> &q)
+{
+	int n = 1 << m, h = n / 2, scale;
+	std::vector<int8_t>  f8(n), g8(n);
+	std::vector<int16_t> f16(n), g16(n);
+
+	re.assign(h + 1, 0);
+	im.assign(h + 1, 0);
+	q.resize(n);
+	for (int i = 0; i < n; i++) {
+		f8[i]  = (int8_t)lrint(x[i] * 127);
+		f16[i] = (int16_t)lrint(x[i] * 32767);
+		q[i]   = (v < COMPLEX16) ? f8[i] / 127.0 : f16[i] / 32767.0;
+	}
+
+	switch (v) {
+	case COMPLEX8:
+		fix_fft(&f8[0], &g8[0], m, 0);
+		for (int k = 0; k <= h; k++) {		// 1/n scaled
+			re[k] = f8[k % n] * (double)n / 127;
+			im[k] = g8[k % n] * (double)n / 127;
+		}
+		break;
+	case REAL8:
+		fix_fftr(&f8[0], m, 0);
+		re[0] = f8[0] * (double)n / 127;
+		re[h] = f8[h] * (double)n / 127;
+		for (int k = 1; k < h; k++) {
+			re[k] = f8[k]     * (double)n / 127;
+			im[k] = f8[h + k] * (double)n / 127;
+		}
+		break;
+	case COMPLEX16:
+		scale = fix_fft(&f16[0], &g16[0], m, 0);
+		for (int k = 0; k <= h; k++) {
+			re[k] = ldexp(f16[k % n], scale) / 32767;
+			im[k] = ldexp(g16[k % n], scale) / 32767;
+		}
+		break;
+	case REAL16:
+		scale = fix_fftr(&f16[0], m, 0);
+		re[0] = ldexp(f16[0], scale) / 32767;
+		re[h] = ldexp(f16[h], scale) / 32767;
+		for (int k = 1; k < h; k++) {
+			re[k] = ldexp(f16[k],     scale) / 32767;
+			im[k] = ldexp(f16[h + k], scale) / 32767;
+		}
+		break;
+	}
+}
+
+// Signal to error ratio in dB against a DFT of the quantized input q[]
+static double accuracy(int v, int m, double level)
+{
+	int n = 1 << m, h = n / 2;
+	double sig = 0, err = 0;
+	std::vector<double> x(n), re, im, q;
+
+	for (int t = 0; t < TRIALS; t++) {
+		double f1 = 1 + rand() % (h - 1), f2 = 1 + rand() % (h - 1);
+		for (int i = 0; i < n; i++)
+			x[i] = level * (0.6 * sin(2 * M_PI * f1 * i / n + t) +
+			                0.3 * sin(2 * M_PI * f2 * i / n) +
+			                0.1 * (rand() / (double)RAND_MAX - 0.5));
+		transform(v, m, x, re, im, q);
+		for (int k = 0; k <= h; k++) {
+			double xr = 0, xi = 0;
+			for (int i = 0; i < n; i++) {
+				xr += q[i] * cos(2 * M_PI * k * i / n);
+				xi -= q[i] * sin(2 * M_PI * k * i / n);
+			}
+			sig += xr * xr + xi * xi;
+			err += (re[k] - xr) * (re[k] - xr) + (im[k] - xi) * (im[k] - xi);
+		}
+	}
+	return err > 0 ? 10 * log10(sig / err) : 999;
+}
+
+static double nsPerTransform(int v, int m)
+{
+	int n = 1 << m;
+	long runs = BENCH_POINTS / n;
+	std::vector<int8_t>  f8(n), g8(n);
+	std::vector<int16_t> f16(n), g16(n);
+
+	clock_t start = clock();
+	for (long r = 0; r < runs; r++) {
+		for (int i = 0; i < n; i++) {		// Fresh input each run
+			f8[i]  = (int8_t)(i * 37 + r);
+			f16[i] = (int16_t)((i * 37 + r) << 7);
+			g8[i]  = 0;
+			g16[i] = 0;
+		}
+		switch (v) {
+		case COMPLEX8:  fix_fft(&f8[0], &g8[0], m, 0);   break;
+		case REAL8:     fix_fftr(&f8[0], m, 0);          break;
+		case COMPLEX16: fix_fft(&f16[0], &g16[0], m, 0); break;
+		case REAL16:    fix_fftr(&f16[0], m, 0);         break;
+		}
+	}
+	return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / runs;
+}
+
+int main(void)
+{
+	printf("%-16s %5s  %12s  %12s  %12s\n", "variant", "N",
+		"SER -1 dBFS", "SER -40 dBFS", "ns/transform");
+
+	for (int v = 0; v < NUM_VARIANTS; v++) {
+		int maxM = (v < COMPLEX16) ? LOG2_N_WAVE : LOG2_N_MAX16;
+		for (int m = 6; m <= maxM; m++) {
+			printf("%-16s %5d  %9.1f dB  %9.1f dB  %12.0f\n",
+				variantNames[v], 1 << m,
+				accuracy(v, m, pow(10, -1 / 20.0)),
+				accuracy(v, m, pow(10, -40 / 20.0)),
+				nsPerTransform(v, m));
+		}
+	}
+	return 0;
+}
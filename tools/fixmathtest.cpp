@@ -0,0 +1,324 @@
+/*
+fixmathtest - checks fixmath.h against the floating point it replaced.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o fixmathtest tools/fixmathtest.cpp && ./fixmathtest
+
+fix_sin() and fix_cos() are compared with 32767 * sin() and cos() at
+all 65536 angles and must stay within FIX_SIN_MAX_ERROR (fixmath.h);
+fix_isqrt() must equal a (int) cast of sqrt() over a sweep of 32 bit
+inputs, and the FIX8_* conversions must truncate and round like the
+float casts they stand for.
+
+Then the pong ball is played both ways: the float ball step and end
+point prediction as pong() had them, and the q8_8 versions from the
+sketch, fed the same sequence of bat flicks.  A flick changes the
+ball's vertical speed by 0.2, which is 51/256 in q8_8.  With that same
+step in both, every frame must plot the ball at the same pixel, hit the
+bats in the same frames, and every prediction must send the bat to the
+same row: the q8_8 code computes exactly what the float code did.  With
+the float code's own 0.2 the two must agree until the first flick, and
+the tool reports how long they go on agreeing after it.
+*/
+
+#include "sketch.h"
+
+#define RALLIES		20000		// Games of pong per starting state
+#define MAX_FRAMES	2000		// Frames per game
+#define PLASMA_FRAMES	100000L		// Frames of drift between the plasmas
+
+static int failed;
+
+static void check(bool ok, const char *what)
+{
+	if (!ok) {
+		printf("FAIL: %s\n", what);
+		failed = 1;
+	}
+}
+
+// pong_get_ball_endpoint() as it was before fixmath.h
+static byte floatEndpoint(float tempballpos_x, float tempballpos_y, float tempballvel_x, float tempballvel_y)
+{
+	while (tempballpos_x > BAT1_X && tempballpos_x < BAT2_X) {
+		tempballpos_x = tempballpos_x + tempballvel_x;
+		tempballpos_y = tempballpos_y + tempballvel_y;
+		if (tempballpos_y <= 0 || tempballpos_y >= 15)
+			tempballvel_y = tempballvel_y * -1;
+	}
+	return tempballpos_y;
+}
+
+// The ball of pong() with float and with q8_8 state.  flick is 0 for a
+// straight rebound, 1 to flick up and 2 to flick down, as random() picks
+// in pong(); the bats are always in the way.
+struct FloatBall {
+	float x, y, vx, vy;
+
+	float flickStep;
+
+	FloatBall(int x0, int y0, int dx, int dy, float flickStep) : x(x0), y(y0),
+		vx(dx), vy(dy * 0.5), flickStep(flickStep) { }
+
+	bool step(int flick)
+	{
+		x = x + vx;
+		y = y + vy;
+		if (y <= 0) {
+			vy = vy * -1;
+			y = 0;
+		}
+		if (y >= 15) {
+			vy = vy * -1;
+			y = 15;
+		}
+		if ((int)x != BAT1_X + 1 && (int)x != BAT2_X)
+			return false;
+		vx = vx * -1;
+		if (flick == 1 && vy < 2)
+			vy = vy + flickStep;
+		if (flick == 2 && vy > flickStep)
+			vy = vy - flickStep;
+		return true;
+	}
+	int plotX(void) { return (int)(x + 0.5); }
+	int plotY(void) { return (int)(y + 0.5); }
+	int endpoint(void) { return floatEndpoint(x, y, vx, vy); }
+};
+
+struct FixBall {
+	q8_8 x, y, vx, vy;
+
+	FixBall(int x0, int y0, int dx, int dy) : x(INT_TO_FIX8(x0)), y(INT_TO_FIX8(y0)),
+		vx(INT_TO_FIX8(dx)), vy(dy > 0 ? FIX8(0.5) : FIX8(-0.5)) { }
+
+	bool step(int flick)
+	{
+		x = x + vx;
+		y = y + vy;
+		if (y <= 0) {
+			vy = vy * -1;
+			y = 0;
+		}
+		if (y >= INT_TO_FIX8(15)) {
+			vy = vy * -1;
+			y = INT_TO_FIX8(15);
+		}
+		if (FIX8_TO_INT(x) != BAT1_X + 1 && FIX8_TO_INT(x) != BAT2_X)
+			return false;
+		vx = vx * -1;
+		if (flick == 1 && vy < INT_TO_FIX8(2))
+			vy = vy + FIX8(0.2);
+		if (flick == 2 && vy > FIX8(0.2))
+			vy = vy - FIX8(0.2);
+		return true;
+	}
+	int plotX(void) { return FIX8_ROUND(x); }
+	int plotY(void) { return FIX8_ROUND(y); }
+	int endpoint(void) { return pong_get_ball_endpoint(x, y, vx, vy); }
+};
+
+static void testTrig(void)
+{
+	double worst[2] = { 0, 0 };
+
+	for (long a = 0; a < 65536; a++) {
+		double rad = a * 2 * M_PI / 65536;
+		double es = fabs(fix_sin(a) - 32767 * sin(rad));
+		double ec = fabs(fix_cos(a) - 32767 * cos(rad));
+		if (es > worst[0])
+			worst[0] = es;
+		if (ec > worst[1])
+			worst[1] = ec;
+	}
+	printf("fix_sin() worst error %.3f LSB, fix_cos() %.3f LSB (bound %d)\n",
+		worst[0], worst[1], FIX_SIN_MAX_ERROR);
+	check(worst[0] <= FIX_SIN_MAX_ERROR, "fix_sin() outside its documented error");
+	check(worst[1] <= FIX_SIN_MAX_ERROR, "fix_cos() outside its documented error");
+
+	check(fix_sin(0) == 0 && fix_sin(0x4000) == 32767 && fix_sin(0xC000) == -32767,
+		"fix_sin() at 0, 90 and 270 degrees");
+	check((uint16_t)FIXANGLE(M_PI / 2) == 0x4000 && FIXANGLE(-M_PI / 2) == -0x4000,
+		"FIXANGLE() of +-pi/2");
+}
+
+static void testConversions(void)
+{
+	bool isqrt = true, trunc = true, round = true;
+
+	for (uint64_t x = 0; x <= 0xFFFFFFFFULL; x += (x < 1000000) ? 1 : 65521)
+		if (fix_isqrt(x) != (uint16_t)sqrt((double)x))
+			isqrt = false;
+	check(fix_isqrt(0xFFFFFFFFUL) == 65535, "fix_isqrt(0xFFFFFFFF)");
+
+	for (long v = -32768; v <= 32767; v++) {
+		q8_8 a = v;
+		if (FIX8_TO_INT(a) != (int)(a / 256.0))
+			trunc = false;
+		if (a >= 0 && a <= 32767 - 128 && FIX8_ROUND(a) != (int)(a / 256.0 + 0.5))
+			round = false;
+	}
+	check(isqrt, "fix_isqrt() differs from (int)sqrt()");
+	check(trunc, "FIX8_TO_INT() differs from a (int) cast");
+	check(round, "FIX8_ROUND() differs from (int)(a + 0.5)");
+}
+
+// Every value near 0, every 97th further out
+static long nextInput(long v)
+{
+	return v + (v > -64 && v < 64 ? 1 : 97);
+}
+
+static void testHypot(void)
+{
+	double worst = 0, worstOld = 0;
+	bool   ok = true;
+
+	for (long x = -32768; x <= 32767; x = nextInput(x))
+		for (long y = -32768; y <= 32767; y = nextInput(y)) {
+			double exact = sqrt((double)x * x + (double)y * y);
+			double h = fix_hypot(x, y);
+			double old = fix_isqrt((uint32_t)(x * x) + (uint32_t)(y * y));
+			if (fabs(h - exact) > exact * 0.013 + 2)
+				ok = false;
+			if (exact >= 4096 && fabs(h - exact) / exact > worst)
+				worst = fabs(h - exact) / exact;
+			if (old >= 4096 && fabs(h - old) / old > worstOld)
+				worstOld = fabs(h - old) / old;
+		}
+	printf("fix_hypot() worst error from 4096 up: %.2f%% of exact, %.2f%% of "
+		"fix_isqrt() of the sum\n", worst * 100, worstOld * 100);
+	check(ok, "fix_hypot() more than 1.3% + 2 from the exact magnitude");
+	check(fix_hypot(-32768, -32768) == 45824, "fix_hypot() at the corner of the range");
+}
+
+// The float plasma's orbits and steps per frame, before fixmath.h
+static const double floatRadius[4]  = { 65.2, 92.0, 163.2, 176.8 },
+                    floatCenterx[4] = { 64.4, 46.4,  93.6,  16.4 },
+                    floatCentery[4] = { 34.8, 26.0,  56.0, -11.6 },
+                    floatSpeed[4]   = { 0.03, -0.07, 0.13, -0.15 };
+
+// Plasma::nextFrame()'s centre of wave k at 'angle'
+static void fixCentre(int k, uint16_t angle, int *x, int *y)
+{
+	*x = FIX16_TO_INT(fix16_mul_q15(radius[k], fix_cos(angle)) + centerx[k]);
+	*y = FIX16_TO_INT(fix16_mul_q15(radius[k], fix_sin(angle)) + centery[k]);
+}
+
+static void floatCentre(int k, float angle, int *x, int *y)
+{
+	*x = (int)(cos(angle) * (float)floatRadius[k] + (float)floatCenterx[k]);
+	*y = (int)(sin(angle) * (float)floatRadius[k] + (float)floatCentery[k]);
+}
+
+static void testPlasma(void)
+{
+	char what[80];
+
+	for (int k = 0; k < 4; k++) {
+		long differ = 0;
+		int  worst = 0, fx, fy, qx, qy;
+
+		for (long a = 0; a < 65536; a++) {
+			fixCentre(k, a, &qx, &qy);
+			floatCentre(k, a * 2 * M_PI / 65536, &fx, &fy);
+			int e = abs(qx - fx) > abs(qy - fy) ? abs(qx - fx) : abs(qy - fy);
+			differ += e != 0;
+			if (e > worst)
+				worst = e;
+		}
+
+		// The speeds, and how long the centres stay together as they run
+		double step = speed[k] * 2 * M_PI / 65536;
+		float  fa = 0;
+		uint16_t qa = 0;
+		long   frames = 0;
+		for (; frames < PLASMA_FRAMES; frames++) {
+			fixCentre(k, qa, &qx, &qy);
+			floatCentre(k, fa, &fx, &fy);
+			if (abs(qx - fx) > 1 || abs(qy - fy) > 1)
+				break;
+			qa += speed[k];
+			fa += (float)floatSpeed[k];
+		}
+
+		printf("plasma wave %d: centre 1 px off at %ld of 65536 angles (worst %d), "
+			"step %.3f%% off, within 1 px for %ld frames\n", k, differ, worst,
+			100 * fabs(step / floatSpeed[k] - 1), frames);
+		snprintf(what, sizeof(what), "plasma wave %d centre more than 1 px from float", k);
+		check(worst <= 1, what);
+		snprintf(what, sizeof(what), "plasma wave %d step more than 0.1%% from float", k);
+		check(fabs(step / floatSpeed[k] - 1) <= 0.001, what);
+	}
+}
+
+// Plays RALLIES games with the float ball using 'flickStep' and the q8_8
+// ball side by side, each until the two first hit a bat in a different
+// frame, plot the ball at a different pixel or predict a different end
+// point.  Counts the frames played and those before the first
+// difference; false if a difference comes before any flick, while the
+// velocities are still the exact 1 and 0.5 both start with.
+static bool playPong(float flickStep, long *frames, long *same)
+{
+	*frames = *same = 0;
+	srand(1);
+	for (long r = 0; r < RALLIES; r++) {
+		int  y0 = 4 + r % 8, dx = (r & 8) ? 1 : -1, dy = (r & 16) ? 1 : -1;
+		bool flicked = false;
+		FloatBall f(16, y0, dx, dy, flickStep);
+		FixBall   q(16, y0, dx, dy);
+
+		for (int i = 0; i < MAX_FRAMES; i++) {
+			int  flick = random(0, 3);
+			bool fh = f.step(flick), qh = q.step(flick), differ;
+
+			differ = fh != qh || f.plotX() != q.plotX() || f.plotY() != q.plotY();
+			// pong() predicts as the ball crosses the middle
+			if ((q.plotX() == 15 && q.vx < 0) || (q.plotX() == 17 && q.vx > 0))
+				differ |= f.endpoint() != q.endpoint();
+			(*frames)++;
+			if (differ) {
+				if (!flicked)
+					return false;
+				break;
+			}
+			(*same)++;
+			flicked |= qh && flick;
+		}
+	}
+	return true;
+}
+
+static void testPong(void)
+{
+	long frames, same;
+	bool ok;
+
+	// The q8_8 arithmetic is exact, and so is float on multiples of 1/256:
+	// with the same flick step the two must play the same games
+	ok = playPong(FIX8(0.2) / 256.0, &frames, &same);
+	printf("pong, float with the q8_8 flick step: %ld of %ld frames the same\n",
+		same, frames);
+	check(ok && same == frames, "q8_8 pong differs from float pong with the same flick step");
+
+	// With the old code's 0.2 the games part once a flick has made the
+	// two velocities 1/1280 pixel per frame apart
+	ok = playPong(0.2, &frames, &same);
+	printf("pong, float with the old 0.2 flick step: the same for %.0f frames "
+		"on average\n", (double)same / RALLIES);
+	check(ok, "q8_8 pong differs from float pong before any flick");
+}
+
+int main(void)
+{
+	testTrig();
+	testConversions();
+	testHypot();
+	testPlasma();
+	testPong();
+	if (!failed)
+		printf("all checks passed\n");
+	return failed;
+}
@@ -0,0 +1,160 @@
+/*
+fontbench - flash size and glyph decode speed of every font bundled in
+fonts.cpp, for each glyph packing drawChar() understands.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o fontbench tools/fontbench.cpp && ./fontbench
+
+Each font is unpacked from its fonts.cpp arrays, in the packing setFont()
+gives it, repacked as rows, bits and rle (see tools/fontpack.h) and every
+glyph is decoded with the same loop as Adafruit_GFX::drawChar().  Decoded
+glyphs are checked against the original so a packer or decoder bug shows
+up here, not on the panel.  The last column is what the packing the font
+ships in saves against rows, in flash bytes, and what it costs in decode
+time.  Timings are host timings; only the ratios between packings carry
+over to the Core.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Pull in every font, whatever fonts.h currently selects
+#define TIMESNEWROMAN8
+#define CENTURYGOTHIC8
+#define ARIAL8
+#define COMICSANSMS8
+#define TESTFONT
+#include "../fonts.cpp"
+
+#include "fontpack.h"
+
+#define DECODE_PASSES	2000
+#define DECODE_RUNS	5
+
+struct BundledFont {
+	const char *name;
+	const uint8_t *bitmaps;
+	const FontDescriptor *descriptors;
+	uint8_t packing;		// As setFont() selects it
+};
+
+static const BundledFont bundled[] = {
+	{ "timesNewRoman_8pt", timesNewRoman_8ptBitmaps, timesNewRoman_8ptDescriptors, FONT_RLE },
+	{ "centuryGothic_8pt", centuryGothic_8ptBitmaps, centuryGothic_8ptDescriptors, FONT_ROWS },
+	{ "arial_8pt",         arial_8ptBitmaps,         arial_8ptDescriptors,         FONT_ROWS },
+	{ "comicSansMS_8pt",   comicSansMS_8ptBitmaps,   comicSansMS_8ptDescriptors,   FONT_ROWS },
+	{ "glcdfont",          glcdfontBitmaps,          glcdfontDescriptors,          FONT_ROWS },
+	{ "font3x5",           font3x5Bitmaps,           font3x5Descriptors,           FONT_BITS },
+	{ "font5x5",           font5x5Bitmaps,           font5x5Descriptors,           FONT_BITS },
+	{ "test",              testBitmaps,              testDescriptors,              FONT_ROWS },
+};
+
+static uint8_t canvas[64 * 64];		// Decode target, 1 byte per pixel
+
+// The pixel loop of Adafruit_GFX::drawChar(), writing into canvas[]
+static void decodeGlyph(const uint8_t *fontData, const FontDescriptor *desc,
+	uint8_t packing)
+{
+	uint8_t  bitCount = 0;
+	uint16_t fontIndex = (desc->offset & ~FONT_RLE_GLYPH) + 2;
+	uint8_t  line = 0, run = 0;
+	bool     rle = (packing == FONT_RLE) && (desc->offset & FONT_RLE_GLYPH),
+	         ink = true;
+
+	for (int8_t i = 0; i < desc->height; i++) {
+		for (int8_t j = 0; j < desc->width; j++) {
+			if (rle) {
+				while (run == 0) {
+					ink = !ink;
+					run = (bitCount++ & 1) ? fontData[fontIndex++] & 0x0F
+					                       : fontData[fontIndex] >> 4;
+				}
+				run--;
+				line = ink ? 0x80 : 0;
+			}
+			else if (bitCount++ % 8 == 0) {
+				line = fontData[fontIndex++];
+			}
+			canvas[i * 64 + j] = (line & 0x80) ? 1 : 0;
+			line <<= 1;
+		}
+		if (packing == FONT_ROWS) bitCount = 0;
+	}
+}
+
+int main(void)
+{
+	printf("%-18s %6s   %-24s %-24s %-24s %s\n", "font", "glyphs",
+		"rows (bytes, ns/glyph)", "bits (bytes, ns/glyph)",
+		"rle (bytes, ns/glyph)", "shipped (saves, time)");
+
+	for (size_t f = 0; f < sizeof(bundled) / sizeof(bundled[0]); f++) {
+		const BundledFont &bf = bundled[f];
+		int first = bf.bitmaps[FONT_START], last = bf.bitmaps[FONT_END];
+		std::vector<Glyph> glyphs(last - first + 1);
+		size_t flash[NUM_PACKINGS];
+		double ns[NUM_PACKINGS];
+
+		// Unpack the fonts.cpp originals
+		for (size_t g = 0; g < glyphs.size(); g++) {
+			decodeGlyph(bf.bitmaps, &bf.descriptors[g], bf.packing);
+			glyphs[g].width   = bf.descriptors[g].width;
+			glyphs[g].height  = bf.descriptors[g].height;
+			glyphs[g].present = true;
+			for (int y = 0; y < glyphs[g].height; y++)
+				for (int x = 0; x < glyphs[g].width; x++)
+					glyphs[g].pix.push_back(canvas[y * 64 + x]);
+		}
+
+		printf("%-18s %6d  ", bf.name, (int)glyphs.size());
+		for (int p = 0; p < NUM_PACKINGS; p++) {
+			std::vector<std::vector<uint8_t> > data;
+			std::vector<uint32_t> offsets;
+			flash[p] = packFont(glyphs, p, data, offsets);
+
+			std::vector<uint8_t> fontData;
+			std::vector<FontDescriptor> desc(glyphs.size());
+			fontData.push_back(first);
+			fontData.push_back(last);
+			for (size_t g = 0; g < glyphs.size(); g++) {
+				fontData.insert(fontData.end(), data[g].begin(), data[g].end());
+				desc[g].width  = glyphs[g].width;
+				desc[g].height = glyphs[g].height;
+				desc[g].offset = offsets[g];
+			}
+
+			for (size_t g = 0; g < glyphs.size(); g++) {
+				decodeGlyph(&fontData[0], &desc[g], p);
+				for (int y = 0; y < glyphs[g].height; y++)
+					for (int x = 0; x < glyphs[g].width; x++)
+						if (canvas[y * 64 + x] != glyphs[g].pix[y * glyphs[g].width + x]) {
+							printf("\n%s: %s glyph 0x%02X decodes wrongly\n",
+								bf.name, packNames[p], (int)(first + g));
+							return 1;
+						}
+			}
+
+			// Best of a few runs, the others include whatever else the
+			// host was doing
+			for (int run = 0; run < DECODE_RUNS; run++) {
+				clock_t start = clock();
+				for (int pass = 0; pass < DECODE_PASSES; pass++)
+					for (size_t g = 0; g < glyphs.size(); g++)
+						decodeGlyph(&fontData[0], &desc[g], p);
+				double t = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC /
+					(DECODE_PASSES * glyphs.size());
+				if (run == 0 || t < ns[p])
+					ns[p] = t;
+			}
+
+			printf(" %6u  %8.1f         ", (unsigned)flash[p], ns[p]);
+		}
+		// fontPacking values and PACK_* numbers are the same
+		printf("%-4s %5d B  %4.2fx\n", packNames[bf.packing],
+			(int)(flash[PACK_ROWS] - flash[bf.packing]), ns[bf.packing] / ns[PACK_ROWS]);
+	}
+	return 0;
+}
@@ -0,0 +1,365 @@
+/*
+fontconv - convert a BDF font or a PBM glyph sheet into the bitmap and
+FontDescriptor arrays used by the multifont GFX library (see fonts.h).
+
+This is a host tool, it is not part of the firmware.  Build it with any
+desktop compiler:
+
+	g++ -O2 -o fontconv tools/fontconv.cpp
+
+Usage:
+
+	fontconv [options] font.bdf   > myfont.cpp
+	fontconv [options] -c WxH sheet.pbm > myfont.cpp
+
+Options:
+	-n name		array name prefix (default: input file name)
+	-r first-last	only convert this character range, e.g. 0x20-0x7E
+	-p rows|bits|rle	glyph packing (default rows):
+			  rows - every glyph row padded to whole bytes,
+			         the layout of the fonts in fonts.cpp
+			  bits - glyph rows run on bit to bit, only the end
+			         of each glyph is padded; select the font
+			         with fontPacking = FONT_BITS in setFont()
+			  rle  - each glyph as bits or as nibble run
+			         lengths, whichever is smaller; select with
+			         fontPacking = FONT_RLE
+	-c WxH		cell size of a PBM glyph sheet (required for PBM)
+	-f first	character code of the first cell in a PBM sheet
+			(default 0x20)
+	-m		monospaced: keep the full cell width of PBM glyphs
+			instead of trimming blank columns on the right
+	-s		report only: print the flash size of the font in
+			every packing to stderr, no source output
+
+The flash bytes used by the generated font (bitmaps + descriptors) are
+always reported on stderr.
+
+PBM sheets (P1 or P4) are read instead of PNG so the tool needs nothing
+but the standard library; any image editor can export them.  Black
+pixels are ink.  Cells run left to right, top to bottom.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "fontpack.h"
+
+struct Font {
+	int first, last;
+	int height;
+	std::vector<Glyph> glyphs;	// first .. last
+};
+
+static void die(const char *msg, const char *arg = "")
+{
+	fprintf(stderr, "fontconv: %s%s\n", msg, arg);
+	exit(1);
+}
+
+
+/*********************** Readers ***********************/
+
+// BDF: every glyph is placed on a common baseline in a cell as tall as
+// the font bounding box.  Its width is the DWIDTH advance less the one
+// column of kerning drawChar() adds, or the inked extent from the origin
+// if that reaches further.
+static void readBDF(FILE *in, Font &font)
+{
+	char line[512];
+	int fbw = 0, fbh = 0, fbx = 0, fby = 0, ascent = -1;
+	int enc = -1, dwidth = 0, bw = 0, bh = 0, bx = 0, by = 0, row = -1;
+	std::vector<uint32_t> rows;
+
+	while (fgets(line, sizeof(line), in)) {
+		if (sscanf(line, "FONTBOUNDINGBOX %d %d %d %d", &fbw, &fbh, &fbx, &fby) == 4)
+			continue;
+		if (sscanf(line, "FONT_ASCENT %d", &ascent) == 1)
+			continue;
+		if (sscanf(line, "ENCODING %d", &enc) == 1)
+			continue;
+		if (sscanf(line, "DWIDTH %d", &dwidth) == 1)
+			continue;
+		if (sscanf(line, "BBX %d %d %d %d", &bw, &bh, &bx, &by) == 4)
+			continue;
+		if (strncmp(line, "BITMAP", 6) == 0) {
+			rows.clear();
+			row = 0;
+			continue;
+		}
+		if (strncmp(line, "ENDCHAR", 7) == 0) {
+			row = -1;
+			if (fbh == 0)
+				die("BDF has no FONTBOUNDINGBOX");
+			if (ascent < 0)
+				ascent = fbh + fby;
+			font.height = fbh;
+			if (enc < font.first || enc > font.last || bw > 32)
+				continue;
+
+			Glyph &g = font.glyphs[enc - font.first];
+			g.present = true;
+			g.height  = fbh;
+			g.width   = (bw > 0 && bx + bw > dwidth - 1) ? bx + bw : dwidth - 1;
+			if (g.width < 1)
+				g.width = 1;
+			g.pix.assign(g.width * g.height, 0);
+
+			int top = ascent - (by + bh);	// First glyph row in the cell
+			for (int y = 0; y < bh && y < (int)rows.size(); y++) {
+				for (int x = 0; x < bw; x++) {
+					int cx = bx + x, cy = top + y;
+					if (cx < 0 || cx >= g.width || cy < 0 || cy >= g.height)
+						continue;
+					// BDF rows are left aligned in whole bytes
+					int bits = ((bw + 7) / 8) * 8;
+					if (rows[y] & (1UL << (bits - 1 - x)))
+						g.pix[cy * g.width + cx] = 1;
+				}
+			}
+			continue;
+		}
+		if (row >= 0)
+			rows.push_back(strtoul(line, NULL, 16));
+	}
+}
+
+static int pbmToken(FILE *in)
+{
+	int c;
+
+	do {
+		c = fgetc(in);
+		if (c == '#')
+			while (c != '\n' && c != EOF)
+				c = fgetc(in);
+	} while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+	if (c == EOF)
+		die("truncated PBM");
+
+	int v = 0;
+	while (c >= '0' && c <= '9') {
+		v = v * 10 + (c - '0');
+		c = fgetc(in);
+	}
+	return v;
+}
+
+static void readPBM(FILE *in, Font &font, int cw, int ch, int firstCell,
+	bool mono)
+{
+	char magic[3] = { 0 };
+	if (fread(magic, 1, 2, in) != 2 || magic[0] != 'P' ||
+			(magic[1] != '1' && magic[1] != '4'))
+		die("not a P1/P4 PBM file");
+
+	int w = pbmToken(in), h = pbmToken(in);
+	std::vector<uint8_t> img(w * h, 0);
+
+	if (magic[1] == '4') {		// Binary: rows padded to whole bytes
+		int stride = (w + 7) / 8;
+		std::vector<uint8_t> buf(stride);
+		for (int y = 0; y < h; y++) {
+			if (fread(&buf[0], 1, stride, in) != (size_t)stride)
+				die("truncated PBM");
+			for (int x = 0; x < w; x++)
+				img[y * w + x] = (buf[x / 8] >> (7 - (x & 7))) & 1;
+		}
+	}
+	else {
+		for (int i = 0; i < w * h; i++) {
+			int c;
+			do { c = fgetc(in); } while (c != '0' && c != '1' && c != EOF);
+			if (c == EOF)
+				die("truncated PBM");
+			img[i] = c - '0';
+		}
+	}
+
+	if (cw <= 0 || ch <= 0 || cw > w || ch > h)
+		die("bad cell size, use -c WxH");
+	font.height = ch;
+
+	int cols = w / cw, cells = cols * (h / ch);
+	for (int n = 0; n < cells; n++) {
+		int code = firstCell + n;
+		if (code < font.first || code > font.last)
+			continue;
+
+		Glyph &g = font.glyphs[code - font.first];
+		int ox = (n % cols) * cw, oy = (n / cols) * ch, right = 0;
+		for (int y = 0; y < ch; y++)
+			for (int x = 0; x < cw; x++)
+				if (img[(oy + y) * w + ox + x] && x + 1 > right)
+					right = x + 1;
+
+		g.present = true;
+		g.height  = ch;
+		g.width   = mono ? cw : (right ? right : (cw + 1) / 2);
+		g.pix.assign(g.width * g.height, 0);
+		for (int y = 0; y < ch; y++)
+			for (int x = 0; x < g.width; x++)
+				g.pix[y * g.width + x] = img[(oy + y) * w + ox + x];
+	}
+}
+
+
+/*********************** Output ***********************/
+
+static void writeSource(const Font &font, const char *name, int packing,
+	const std::vector<std::vector<uint8_t> > &data,
+	const std::vector<uint32_t> &offsets)
+{
+	printf("// Generated by tools/fontconv (%s packing)\n\n", packNames[packing]);
+	printf("// Character bitmaps for %s\n", name);
+	printf("const uint8_t %sBitmaps[] = \n{\n", name);
+	printf("\t0x%02X, 0x%02X,\t\t// Start Character, End Character\n",
+		font.first, font.last);
+	for (size_t i = 0; i < data.size(); i++) {
+		if (data[i].empty())	// Shares another glyph's bitmap
+			continue;
+		printf("\t");
+		for (size_t j = 0; j < data[i].size(); j++)
+			printf("0x%02X, ", data[i][j]);
+		printf("\n");
+	}
+	printf("};\n\n");
+
+	printf("// Character descriptors for %s\n", name);
+	printf("// { [Char width in bits], [Char height in bits], [Offset into %sBitmaps in bytes] }\n", name);
+	printf("const FontDescriptor %sDescriptors[] =\n{\n", name);
+	for (size_t i = 0; i < data.size(); i++) {
+		int c = font.first + i;
+		if ((offsets[i] & ~RLE_GLYPH) > (packing == PACK_RLE ? 0x7FFFU : 0xFFFFU))
+			die("font too large for 16 bit descriptor offsets");
+		if (offsets[i] & RLE_GLYPH)
+			printf("\t{%d, %d, %u | FONT_RLE_GLYPH}, \t", font.glyphs[i].width,
+				font.glyphs[i].height, (unsigned)(offsets[i] & ~RLE_GLYPH));
+		else
+			printf("\t{%d, %d, %u}, \t", font.glyphs[i].width,
+				font.glyphs[i].height, (unsigned)offsets[i]);
+		if (c > 0x20 && c < 0x7F && c != '\\')
+			printf("// '%c'\n", c);
+		else
+			printf("// 0x%02X\n", c);
+	}
+	printf("};\n");
+}
+
+int main(int argc, char **argv)
+{
+	const char *name = NULL, *path = NULL;
+	int first = 0x00, last = 0xFF, packing = PACK_ROWS;
+	int cw = 0, ch = 0, firstCell = 0x20;
+	bool mono = false, reportOnly = false;
+
+	for (int i = 1; i < argc; i++) {
+		const char *a = argv[i];
+		if (!strcmp(a, "-n") && i + 1 < argc)
+			name = argv[++i];
+		else if (!strcmp(a, "-r") && i + 1 < argc) {
+			char *end;
+			first = strtol(argv[++i], &end, 0);
+			if (*end != '-')
+				die("bad range ", argv[i]);
+			last = strtol(end + 1, NULL, 0);
+		}
+		else if (!strcmp(a, "-p") && i + 1 < argc) {
+			i++;
+			for (packing = 0; packing < NUM_PACKINGS; packing++)
+				if (!strcmp(argv[i], packNames[packing]))
+					break;
+			if (packing == NUM_PACKINGS)
+				die("unknown packing ", argv[i]);
+		}
+		else if (!strcmp(a, "-c") && i + 1 < argc) {
+			if (sscanf(argv[++i], "%dx%d", &cw, &ch) != 2)
+				die("bad cell size ", argv[i]);
+		}
+		else if (!strcmp(a, "-f") && i + 1 < argc)
+			firstCell = strtol(argv[++i], NULL, 0);
+		else if (!strcmp(a, "-m"))
+			mono = true;
+		else if (!strcmp(a, "-s"))
+			reportOnly = true;
+		else if (a[0] == '-')
+			die("unknown option ", a);
+		else
+			path = a;
+	}
+	if (!path)
+		die("usage: fontconv [-n name] [-r first-last] [-p rows|bits|rle] "
+			"[-c WxH] [-f first] [-m] [-s] font.bdf|sheet.pbm");
+	if (first < 0 || last > 0xFF || first > last)
+		die("range must lie within 0x00-0xFF");
+
+	FILE *in = fopen(path, "rb");
+	if (!in)
+		die("can't open ", path);
+
+	Font font;
+	font.first  = first;
+	font.last   = last;
+	font.height = 0;
+	font.glyphs.resize(last - first + 1);
+	for (size_t i = 0; i < font.glyphs.size(); i++)
+		font.glyphs[i].present = false;
+
+	std::string base(path);
+	size_t dot = base.find_last_of('.'), slash = base.find_last_of("/\\");
+	std::string ext = (dot == std::string::npos) ? "" : base.substr(dot);
+	if (ext == ".pbm" || ext == ".PBM")
+		readPBM(in, font, cw, ch, firstCell, mono);
+	else
+		readBDF(in, font);
+	fclose(in);
+
+	// Trim the range to the glyphs that exist, then fill any gaps with
+	// blank glyphs the width of a space so every code in range draws;
+	// packFont() gives them all one bitmap
+	while (font.first < font.last && !font.glyphs.front().present) {
+		font.glyphs.erase(font.glyphs.begin());
+		font.first++;
+	}
+	while (font.last > font.first && !font.glyphs.back().present) {
+		font.glyphs.pop_back();
+		font.last--;
+	}
+	if (!font.glyphs.front().present)
+		die("no glyphs in range");
+	int blank = (' ' >= font.first && ' ' <= font.last) ?
+		font.glyphs[' ' - font.first].width : 1;
+	for (size_t i = 0; i < font.glyphs.size(); i++) {
+		Glyph &g = font.glyphs[i];
+		if (!g.present) {
+			g.width  = blank;
+			g.height = font.height;
+			g.pix.assign(g.width * g.height, 0);
+		}
+	}
+
+	if (!name) {
+		base = base.substr(slash == std::string::npos ? 0 : slash + 1);
+		name = strdup(base.substr(0, base.find('.')).c_str());
+	}
+
+	std::vector<std::vector<uint8_t> > data;
+	std::vector<uint32_t> offsets;
+	fprintf(stderr, "%s: 0x%02X-0x%02X, %d glyphs, %d px high\n", name,
+		font.first, font.last, (int)font.glyphs.size(), font.height);
+	for (int p = 0; p < NUM_PACKINGS; p++) {
+		if (reportOnly || p == packing)
+			fprintf(stderr, "  %-5s %6u flash bytes\n", packNames[p],
+				(unsigned)packFont(font.glyphs, p, data, offsets));
+	}
+	if (reportOnly)
+		return 0;
+
+	packFont(font.glyphs, packing, data, offsets);
+	writeSource(font, name, packing, data, offsets);
+	return 0;
+}
@@ -0,0 +1,125 @@
+/*
+Glyph packers shared by the host font tools (fontconv, fontbench).  The
+layouts match what Adafruit_GFX::drawChar() decodes for each
+fontPacking setting, see fonts.h.
+*/
+
+#ifndef _FONTPACK_H
+#define _FONTPACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#define PACK_ROWS	0	// FONT_ROWS
+#define PACK_BITS	1	// FONT_BITS
+#define PACK_RLE	2	// FONT_RLE
+#define NUM_PACKINGS	3
+
+static const char *packNames[NUM_PACKINGS] = { "rows", "bits", "rle" };
+
+// Descriptor offset flag for run-length coded glyphs (FONT_RLE_GLYPH)
+#define RLE_GLYPH	0x8000
+
+struct Glyph {
+	int width, height;
+	bool present;
+	std::vector<uint8_t> pix;	// width * height, 1 = ink
+};
+
+static void packBits(const Glyph &g, bool padRows, std::vector<uint8_t> &out)
+{
+	uint8_t acc = 0;
+	int     n   = 0;
+
+	for (int y = 0; y < g.height; y++) {
+		for (int x = 0; x < g.width; x++) {
+			acc = (acc << 1) | g.pix[y * g.width + x];
+			if (++n == 8) {
+				out.push_back(acc);
+				acc = n = 0;
+			}
+		}
+		if (padRows && n) {
+			out.push_back(acc << (8 - n));
+			acc = n = 0;
+		}
+	}
+	if (n)
+		out.push_back(acc << (8 - n));
+}
+
+// Nibble runs, alternating background / ink and starting with background.
+// A run longer than 15 is split as 15, 0 (empty run of the other colour),
+// remainder.  High nibble first.
+static void packRuns(const Glyph &g, std::vector<uint8_t> &out)
+{
+	std::vector<uint8_t> nibbles;
+	int ink = 0, run = 0;
+
+	for (size_t i = 0; i <= g.pix.size(); i++) {
+		if (i < g.pix.size() && g.pix[i] == ink) {
+			run++;
+			continue;
+		}
+		while (run > 15) {
+			nibbles.push_back(15);
+			nibbles.push_back(0);
+			run -= 15;
+		}
+		nibbles.push_back(run);
+		ink = !ink;
+		run = 1;
+	}
+	for (size_t i = 0; i < nibbles.size(); i += 2)
+		out.push_back((nibbles[i] << 4) |
+			(i + 1 < nibbles.size() ? nibbles[i + 1] : 0));
+}
+
+// Pack one glyph.  FONT_RLE fonts store each glyph either as a bitstream or
+// as runs, whichever is smaller; returns true if runs were chosen.
+static bool packGlyph(const Glyph &g, int packing, std::vector<uint8_t> &out)
+{
+	if (packing != PACK_RLE) {
+		packBits(g, packing == PACK_ROWS, out);
+		return false;
+	}
+
+	std::vector<uint8_t> bits, runs;
+	packBits(g, false, bits);
+	packRuns(g, runs);
+	if (runs.size() < bits.size()) {
+		out.insert(out.end(), runs.begin(), runs.end());
+		return true;
+	}
+	out.insert(out.end(), bits.begin(), bits.end());
+	return false;
+}
+
+// Pack a whole font; data[i] and offsets[i] (flags included) per glyph.
+// Glyphs that are not present are blanks of one size and all point at
+// the first one's bitmap; their own data[i] is left empty.  Returns the
+// flash size: start/end bytes, bitmaps and descriptors.
+static size_t packFont(const std::vector<Glyph> &glyphs, int packing,
+	std::vector<std::vector<uint8_t> > &data, std::vector<uint32_t> &offsets)
+{
+	size_t bytes = 0, blank = glyphs.size();
+
+	data.clear();
+	offsets.clear();
+	for (size_t i = 0; i < glyphs.size(); i++) {
+		data.push_back(std::vector<uint8_t>());
+		if (!glyphs[i].present && blank < i) {
+			offsets.push_back(offsets[blank]);
+			continue;
+		}
+		if (!glyphs[i].present)
+			blank = i;
+		bool rle = packGlyph(glyphs[i], packing, data.back());
+		offsets.push_back(bytes | (rle ? RLE_GLYPH : 0));
+		bytes += data.back().size();
+	}
+	return 2 + bytes + glyphs.size() * 4;	// sizeof(FontDescriptor) == 4
+}
+
+#endif // _FONTPACK_H
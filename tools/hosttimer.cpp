@@ -0,0 +1,95 @@
+/*
+Host stand-in for SparkIntervalTimer.cpp.  Each hardware timer slot
+becomes a HostTimer in tools/application.h, whose callback runs when
+delay() or delayMicroseconds() moves the clock past its due time; a
+tool that wants to clock a driver by hand can also call
+IntervalTimer::SIT_CALLBACK[slot]() itself.
+
+The class and its slots are the ones SparkIntervalTimer.h declares, so
+RGBmatrixPanel and AudioSampler build unchanged.
+*/
+
+#include "../SparkIntervalTimer.h"
+
+bool IntervalTimer::SIT_used[];
+IntervalTimer::ISRcallback IntervalTimer::SIT_CALLBACK[];
+
+// Referenced by the constructor; never called on the host
+void Wiring_TIM3_Interrupt_Handler_override(void) { }
+void Wiring_TIM4_Interrupt_Handler_override(void) { }
+void Wiring_TIM5_Interrupt_Handler_override(void) { }
+void Wiring_TIM6_Interrupt_Handler_override(void) { }
+void Wiring_TIM7_Interrupt_Handler_override(void) { }
+
+static uint32_t hostPeriod(intPeriod period, bool scale)
+{
+	return (scale == hmSec) ? period * 500UL : period;
+}
+
+bool IntervalTimer::beginCycles(void (*isrCallback)(), intPeriod Period, bool scale, TIMid id)
+{
+	if (status == TIMER_SIT) {
+		stop_SIT();
+		status = TIMER_OFF;
+	}
+	myISRcallback = isrCallback;
+	status = allocate_SIT(Period, scale, (id < NUM_SIT) ? id : AUTO) ? TIMER_SIT : TIMER_OFF;
+	return status != TIMER_OFF;
+}
+
+bool IntervalTimer::allocate_SIT(intPeriod Period, bool scale, TIMid id)
+{
+	for (uint8_t tid = 0; tid < NUM_SIT; tid++)
+		if ((id == AUTO || id == tid) && !SIT_used[tid]) {
+			SIT_id = tid;
+			SIT_used[tid] = true;
+			start_SIT(Period, scale);
+			return true;
+		}
+	return false;
+}
+
+void IntervalTimer::start_SIT(intPeriod Period, bool scale)
+{
+	HostTimer &t = hostClock().timers[SIT_id];
+
+	SIT_CALLBACK[SIT_id] = myISRcallback;
+	t.isr    = myISRcallback;
+	t.period = hostPeriod(Period, scale);
+	t.next   = hostMicros() + t.period;
+}
+
+void IntervalTimer::end()
+{
+	if (status == TIMER_SIT)
+		stop_SIT();
+	status = TIMER_OFF;
+}
+
+void IntervalTimer::stop_SIT()
+{
+	hostClock().timers[SIT_id].isr = NULL;
+	SIT_CALLBACK[SIT_id] = NULL;
+	SIT_used[SIT_id] = false;
+}
+
+void IntervalTimer::interrupt_SIT(action ACT)
+{
+	hostClock().timers[SIT_id].isr = (ACT == INT_ENABLE) ? myISRcallback : NULL;
+}
+
+// Like reloading the hardware counter: the next interrupt comes a new
+// period after the last one
+void IntervalTimer::resetPeriod_SIT(intPeriod newPeriod, bool scale)
+{
+	HostTimer &t = hostClock().timers[SIT_id];
+
+	t.next  -= t.period;
+	t.period = hostPeriod(newPeriod, scale);
+	t.next  += t.period;
+}
+
+int8_t IntervalTimer::isAllocated_SIT(void)
+{
+	return (status == TIMER_SIT) ? SIT_id : -1;
+}
@@ -0,0 +1,138 @@
+/*
+indexbench - a plasma frame drawn through the panel's indexed mode
+against the same frame drawn in direct color, row by row and pixel by
+pixel.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o indexbench tools/indexbench.cpp && ./indexbench
+
+Each frame is drawn as plasma() draws it: in direct color each row of
+huePalette() colors goes to drawRow(); in indexed mode each row of
+indices is copied with drawIndexRow(), the 256 palette entries are set
+and swapBuffers() resolves the index buffer into the bit planes.  The
+way plasma() drew in direct color before drawRow(), every pixel through
+drawPixel(), is timed too.  In all four rotations all three must put
+the same frame on the panel.  The CPU time per frame counts the drawing
+and the swap, but not the wait for the refresh interrupt inside it (see
+tools/application.h).  Host timings; only the ratios carry over to the
+Core.
+*/
+
+#include "sketch.h"
+
+#define FRAMES		5000		// Per timing run
+
+static Plasma  field;
+static uint8_t hues;
+
+static void pixelFrame(void)
+{
+	uint8_t row[64];
+
+	field.nextFrame();
+	for (int y = 0; y < matrix.height(); y++) {
+		field.renderRow(y, row, matrix.width());
+		for (int x = 0; x < matrix.width(); x++)
+			matrix.drawPixel(x, y, matrix.huePalette((2 * row[x] + hues) * 3));
+	}
+	matrix.swapBuffers(false);
+	hues += 2;
+}
+
+static void rowFrame(void)
+{
+	uint8_t  row[64];
+	rgb444_t colors[64];
+
+	field.nextFrame();
+	for (int y = 0; y < matrix.height(); y++) {
+		field.renderRow(y, row, matrix.width());
+		for (int x = 0; x < matrix.width(); x++)
+			colors[x] = RGBmatrixPanel::RGB444(matrix.huePalette((2 * row[x] + hues) * 3));
+		matrix.drawRow(y, colors);
+	}
+	matrix.swapBuffers(false);
+	hues += 2;
+}
+
+static void indexedFrame(void)
+{
+	uint8_t row[64];
+
+	field.nextFrame();
+	for (int y = 0; y < matrix.height(); y++) {
+		field.renderRow(y, row, matrix.width());
+		matrix.drawIndexRow(y, row);
+	}
+	for (int i = 0; i < 256; i++)
+		matrix.setPaletteColor(i, matrix.huePalette((2 * i + hues) * 3));
+	matrix.swapBuffers(false);
+	hues += 2;
+}
+
+// CPU us per frame of FRAMES frames drawn with f
+static double cpuPerFrame(void (*f)(void))
+{
+	uint64_t busy = hostBusyMicros();
+
+	for (long i = 0; i < FRAMES; i++)
+		f();
+	return (double)(hostBusyMicros() - busy) / FRAMES;
+}
+
+int main(void)
+{
+	int    failed = 0;
+	size_t size;
+
+	sketchInit();
+	matrix.setHuePalette(255, 255, true);
+	size = matrix.width() * matrix.height() / 2 * 3;
+
+	uint8_t *pixels = new uint8_t[size];
+	for (uint8_t r = 0; r < 4; r++) {
+		matrix.setRotation(r);
+		field = Plasma();
+		hues = 0;
+		matrix.setIndexed(false);
+		pixelFrame();
+		memcpy(pixels, matrix.frontBuffer(), size);
+
+		field = Plasma();
+		hues = 0;
+		rowFrame();
+		if (memcmp(pixels, matrix.frontBuffer(), size)) {
+			printf("rotation %d: the frame drawn by rows differs from the one by pixels\n", r);
+			failed = 1;
+		}
+
+		field = Plasma();
+		hues = 0;
+		if (!matrix.setIndexed(true)) {
+			printf("no memory for indexed mode\n");
+			return 1;
+		}
+		indexedFrame();
+		if (memcmp(pixels, matrix.frontBuffer(), size)) {
+			printf("rotation %d: the indexed frame differs from the direct one\n", r);
+			failed = 1;
+		}
+	}
+	delete[] pixels;
+	matrix.setRotation(0);
+
+	matrix.setIndexed(false);
+	double tPixel = cpuPerFrame(pixelFrame);
+	double tRow = cpuPerFrame(rowFrame);
+	matrix.setIndexed(true);
+	double tIndexed = cpuPerFrame(indexedFrame);
+	matrix.setIndexed(false);
+
+	printf("%dx%d plasma frame, CPU per frame\n", matrix.width(), matrix.height());
+	printf("%-28s  %8.2f us\n", "direct, drawPixel()", tPixel);
+	printf("%-28s  %8.2f us  (%.1fx)\n", "direct, drawRow()", tRow, tPixel / tRow);
+	printf("%-28s  %8.2f us  (%.1fx)\n", "indexed", tIndexed, tPixel / tIndexed);
+	return failed;
+}
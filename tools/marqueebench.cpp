@@ -0,0 +1,81 @@
+/*
+marqueebench - CPU time per second of the marquee face, and of the
+scrolling message on its own next to the way it used to be drawn.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o marqueebench tools/marqueebench.cpp && ./marqueebench
+
+It builds the sketch with tools/sketch.h and runs marquee() itself for
+a while, then scrollMessage() for messages of several lengths, and for
+comparison the same scroll drawn the old way: cls(), both lines through
+drawString() and swapBuffers() at every step, every glyph rasterized
+again each time.  The 50 ms steps and the waits for the panel refresh
+cost no host time (see tools/application.h), so what is reported is
+the CPU the drawing takes per second of scrolling.  Host timings; only
+the ratio between the two carries over to the Core.
+*/
+
+#include "sketch.h"
+
+#define SECONDS		30		// Of marquee() to run
+
+// scrollMessage() as it was before the text strip
+static void scrollRedraw(char *top, char *bottom, uint8_t topFont, uint8_t bottomFont,
+	uint16_t topColor, uint16_t bottomColor)
+{
+	int l = ((strlen(top) > strlen(bottom) ? strlen(top) : strlen(bottom)) * -5) - 32;
+
+	for (int i = 32; i > l; i--) {
+		cls();
+		drawString(i, 1, top, topFont, topColor);
+		drawString(i, 9, bottom, bottomFont, bottomColor);
+		matrix.swapBuffers(false);
+		delay(50);
+		Spark.process();
+	}
+}
+
+// CPU us per second of (virtual) running time while f runs
+template<class F> static double cpuPerSecond(F f)
+{
+	uint64_t busy = hostBusyMicros(), start = hostMicros();
+	f();
+	return (double)(hostBusyMicros() - busy) * 1e6 / (hostMicros() - start);
+}
+
+int main(void)
+{
+	static const char *messages[] = {
+		"HAPPY NEW YEAR",
+		"  WELCOME TO PONG CLOCK",
+		"HAPPY BIRTHDAY CHASE AND CHANDLER",
+		"ONE LINE OF FORTY CHARACTERS, THE LIMIT",
+	};
+	char top[] = "WED JUL 14 12:34:00 2017";
+
+	sketchInit();
+
+	showClock = SECONDS;
+	double marqueeCpu = cpuPerSecond([] { marquee(); });
+	printf("marquee(): %.0f us of CPU per second (%.3f%%)\n\n",
+		marqueeCpu, marqueeCpu / 1e4);
+
+	printf("%-40s  %16s  %16s  %8s\n", "bottom line", "redraw us/s",
+		"strip us/s", "ratio");
+	for (size_t m = 0; m < sizeof(messages) / sizeof(messages[0]); m++) {
+		char bottom[64];
+		strcpy(bottom, messages[m]);
+
+		double redraw = cpuPerSecond([&] {
+			scrollRedraw(top, bottom, 53, 53, Green, Navy);
+		});
+		double strip = cpuPerSecond([&] {
+			scrollMessage(top, bottom, 53, 53, Green, Navy);
+		});
+		printf("%-40s  %16.0f  %16.0f  %7.1fx\n", bottom, redraw, strip,
+			redraw / strip);
+	}
+	return 0;
+}
@@ -0,0 +1,100 @@
+/*
+palettebench - RGBmatrixPanel::huePalette() against the ColorHSV() call
+it stands in for.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o palettebench tools/palettebench.cpp && ./palettebench
+
+First huePalette() must return exactly what ColorHSV() does, for hues
+well outside 0..1535 on both sides, at several saturation, value and
+gamma settings (each one rebuilds the table).  Then the colors of
+plasma frames, the hues plasma() draws with, are looked up both ways,
+on their own and together with drawing each pixel.  Host timings, and a
+PC multiplies much faster than the Core; only the ratios mean anything
+there.
+*/
+
+#include "sketch.h"
+
+#define FRAMES		5000		// Plasma frames per timing run
+#define HUE_RANGE	4608		// Hues checked: -HUE_RANGE .. +HUE_RANGE
+
+static const struct { uint8_t sat, val; boolean gflag; } settings[] = {
+	{ 255, 255, true }, { 255, 255, false }, { 200, 128, true }, { 64, 32, false }
+};
+
+static double seconds(std::chrono::steady_clock::time_point t0)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	sketchInit();
+
+	for (size_t s = 0; s < sizeof(settings) / sizeof(settings[0]); s++) {
+		long wrong = 0;
+
+		matrix.setHuePalette(settings[s].sat, settings[s].val, settings[s].gflag);
+		for (long hue = -HUE_RANGE; hue <= HUE_RANGE; hue++)
+			if (matrix.huePalette(hue) != matrix.ColorHSV(hue, settings[s].sat,
+				settings[s].val, settings[s].gflag))
+				wrong++;
+		printf("sat %3d val %3d gamma %d: %ld of %d hues differ from ColorHSV()\n",
+			settings[s].sat, settings[s].val, settings[s].gflag, wrong,
+			2 * HUE_RANGE + 1);
+		if (wrong)
+			failed = 1;
+	}
+
+	// The hues of a run of plasma frames, as plasma() computes them
+	int      width = matrix.width(), height = matrix.height(), pixels = width * height;
+	long    *hues = new long[(long)FRAMES * pixels];
+	uint8_t  row[64];
+	Plasma   field;
+
+	for (long f = 0; f < FRAMES; f++) {
+		field.nextFrame();
+		for (int y = 0; y < height; y++) {
+			field.renderRow(y, row, width);
+			for (int x = 0; x < width; x++)
+				hues[(f * height + y) * width + x] = (2 * row[x] + 2 * f) * 3;
+		}
+	}
+	matrix.setHuePalette(255, 255, true);
+
+	volatile uint16_t sink = 0;
+	double t[4];
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	for (long i = 0; i < (long)FRAMES * pixels; i++)
+		sink += matrix.ColorHSV(hues[i], 255, 255, true);
+	t[0] = seconds(t0);
+
+	t0 = std::chrono::steady_clock::now();
+	for (long i = 0; i < (long)FRAMES * pixels; i++)
+		sink += matrix.huePalette(hues[i]);
+	t[1] = seconds(t0);
+
+	t0 = std::chrono::steady_clock::now();
+	for (long i = 0; i < (long)FRAMES * pixels; i++)
+		matrix.drawPixel(i % width, i / width % height, matrix.ColorHSV(hues[i], 255, 255, true));
+	t[2] = seconds(t0);
+
+	t0 = std::chrono::steady_clock::now();
+	for (long i = 0; i < (long)FRAMES * pixels; i++)
+		matrix.drawPixel(i % width, i / width % height, matrix.huePalette(hues[i]));
+	t[3] = seconds(t0);
+	delete[] hues;
+
+	printf("\n%dx%d plasma frame         %12s  %12s  %8s\n", width, height,
+		"ColorHSV()", "huePalette()", "ratio");
+	printf("%-28s  %9.0f ns  %9.0f ns  %7.1fx\n", "colors only",
+		t[0] * 1e9 / FRAMES, t[1] * 1e9 / FRAMES, t[0] / t[1]);
+	printf("%-28s  %9.0f ns  %9.0f ns  %7.1fx\n", "colors and drawPixel()",
+		t[2] * 1e9 / FRAMES, t[3] * 1e9 / FRAMES, t[2] / t[3]);
+	return failed;
+}
@@ -0,0 +1,153 @@
+/*
+plasmabench - the plasma kernel in Plasma.cpp against the one it
+replaced, which squared each wave's distance at every pixel.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o plasmabench tools/plasmabench.cpp && ./plasmabench
+
+Both kernels render the same frames (the wave centres come from the
+same Plasma::nextFrame() sequence) at every panel size the sketch
+supports; every frame must come out identical.  The lower resolutions
+FramePacer can ask for (every 2nd and 4th pixel of every 2nd and 4th
+row) must show exactly the full resolution pixels they sample.
+Frames per second are host timings of the kernel alone, without
+drawing; only the ratios carry over to the Core.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "../fixmath.cpp"
+#include "../Plasma.cpp"
+
+#define FRAMES		2000
+
+static const struct { int width, height; } sizes[] = {
+	{ 32, 16 }, { 32, 32 }, { 64, 32 }
+};
+
+// The original kernel: the centres as Plasma::nextFrame() computes them,
+// then a multiply-add per wave per pixel
+struct Reference {
+	uint16_t angle[4];
+
+	Reference(void) { memset(angle, 0, sizeof(angle)); }
+
+	void frame(uint8_t *out, int width, int height)
+	{
+		int sx[4], sy[4];
+
+		for (int k = 0; k < 4; k++) {
+			sx[k] = FIX16_TO_INT(fix16_mul_q15(radius[k], fix_cos(angle[k])) + centerx[k]);
+			sy[k] = FIX16_TO_INT(fix16_mul_q15(radius[k], fix_sin(angle[k])) + centery[k]);
+			angle[k] += speed[k];
+		}
+		for (int y = 0; y < height; y++) {
+			int x1 = sx[0], x2 = sx[1], x3 = sx[2], x4 = sx[3];
+			int y1 = sy[0] - y, y2 = sy[1] - y, y3 = sy[2] - y, y4 = sy[3] - y;
+			for (int x = 0; x < width; x++) {
+				long value = (int8_t)pgm_read_byte(sinetab + (uint8_t)((x1 * x1 + y1 * y1) >> 4))
+					+ (int8_t)pgm_read_byte(sinetab + (uint8_t)((x2 * x2 + y2 * y2) >> 4))
+					+ (int8_t)pgm_read_byte(sinetab + (uint8_t)((x3 * x3 + y3 * y3) >> 5))
+					+ (int8_t)pgm_read_byte(sinetab + (uint8_t)((x4 * x4 + y4 * y4) >> 5));
+				*out++ = (uint8_t)(value >> 1);
+				x1--; x2--; x3--; x4--;
+			}
+		}
+	}
+};
+
+// The sketch's loop: every step-th row, copied into the rows it stands for
+static void engine(Plasma &p, uint8_t *out, int width, int height, int step = 1)
+{
+	p.nextFrame();
+	for (int y = 0; y < height; y += step) {
+		p.renderRow(y, out + y * width, width, step);
+		for (int r = y + 1; r < y + step && r < height; r++)
+			memcpy(out + r * width, out + y * width, width);
+	}
+}
+
+static double seconds(std::chrono::steady_clock::time_point t0)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(void)
+{
+	static uint8_t a[64 * 32], b[64 * 32];
+	volatile unsigned sink = 0;	// Keeps the frames from being optimized away
+	int failed = 0;
+
+	printf("%7s  %14s  %12s  %8s  %12s  %12s\n", "panel", "per-pixel fps",
+		"Plasma fps", "speedup", "1/2 res fps", "1/4 res fps");
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+		int w = sizes[s].width, h = sizes[s].height;
+		long mismatched = 0;
+
+		// Same output, frame for frame (long enough for every angle to wrap)
+		{
+			Reference ref;
+			Plasma    p;
+			for (long f = 0; f < 40000; f++) {
+				ref.frame(a, w, h);
+				engine(p, b, w, h);
+				if (memcmp(a, b, w * h))
+					mismatched++;
+			}
+		}
+		for (int step = 2; step <= 4; step *= 2) {
+			Reference ref;
+			Plasma    p;
+			for (long f = 0; f < 40000; f++) {
+				ref.frame(a, w, h);
+				engine(p, b, w, h, step);
+				for (int i = 0; i < w * h; i++)
+					if (b[i] != a[(i / w) / step * step * w + (i % w) / step * step]) {
+						mismatched++;
+						break;
+					}
+			}
+		}
+
+		Reference ref;
+		Plasma    p;
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		for (long f = 0; f < FRAMES; f++) {
+			ref.frame(a, w, h);
+			sink += a[f % (w * h)];
+		}
+		double tRef = seconds(t0);
+
+		t0 = std::chrono::steady_clock::now();
+		for (long f = 0; f < FRAMES; f++) {
+			engine(p, b, w, h);
+			sink += b[f % (w * h)];
+		}
+		double tEngine = seconds(t0);
+
+		double tStep[2];
+		for (int i = 0; i < 2; i++) {
+			t0 = std::chrono::steady_clock::now();
+			for (long f = 0; f < FRAMES; f++) {
+				engine(p, b, w, h, 2 << i);
+				sink += b[f % (w * h)];
+			}
+			tStep[i] = seconds(t0);
+		}
+
+		printf("  %2dx%-2d  %14.0f  %12.0f  %7.2fx  %12.0f  %12.0f", w, h,
+			FRAMES / tRef, FRAMES / tEngine, tRef / tEngine,
+			FRAMES / tStep[0], FRAMES / tStep[1]);
+		if (mismatched) {
+			printf("  (%ld frames differ)", mismatched);
+			failed = 1;
+		}
+		printf("\n");
+	}
+	return failed;
+}
@@ -0,0 +1,320 @@
+/*
+samplertest - AudioSampler driven from a generated signal.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o samplertest tools/samplertest.cpp && ./samplertest
+
+The sampler is built against tools/application.h and tools/hosttimer.cpp
+and reads a counter through setSource(), so every sample says when it
+was taken.  The sampler is clocked by hand, by calling sample() or the
+timer slot's callback, and the tool checks:
+
+ - a block is handed over as soon as it is full, and holds consecutive
+   samples; a reader that calls read() again before the next block is
+   full loses nothing;
+ - unread blocks are replaced by newer ones, and a reader that still
+   holds one block when the other is full pauses sampling; overruns()
+   counts each of those exactly, and release() resumes sampling;
+ - the block the reader holds is never written, under any interleaving
+   of samples, reads and releases (a long random run);
+ - a reader on the simulated clock that polls every 5 ms, more than half
+   a 64 sample block at 8 kHz, and calls release() once it has copied a
+   block, as the sketch does, loses no samples and sees no overruns;
+   the tool also reports how many it sees without release().
+ - begin() sets the timer to the rate, and on the simulated clock
+   delay() delivers rate * time samples.
+*/
+
+#include "application.h"
+#include "hosttimer.cpp"
+#include "../AudioSampler.cpp"
+
+#define BLOCK		128
+#define RATE		8000
+#define RANDOM_STEPS	2000000L	// sample() and read() calls in the random run
+#define SLOW_BLOCK	64		// The sketch's SPECTRUM_HOP
+#define SLOW_POLL_MS	5		// More than half a SLOW_BLOCK at RATE
+#define SLOW_BLOCKS	1200L
+
+static int      failed;
+static uint16_t counter;	// Next value of the signal
+
+static uint16_t countingSource(uint8_t)
+{
+	return counter++;
+}
+
+static void check(bool ok, const char *what)
+{
+	if (!ok) {
+		printf("FAIL: %s\n", what);
+		failed = 1;
+	}
+}
+
+// True if block holds n consecutive counter values from 'first'
+static bool consecutive(const uint16_t *block, uint16_t first, int n = BLOCK)
+{
+	for (int i = 0; i < n; i++)
+		if (block[i] != (uint16_t)(first + i))
+			return false;
+	return true;
+}
+
+static void clock(AudioSampler &s, long n)
+{
+	while (n--)
+		s.sample();
+}
+
+static void testHandoff(AudioSampler &s)
+{
+	const uint16_t *b;
+
+	counter = 0;
+	s.end();
+	check(s.begin(RATE), "begin()");
+	clock(s, BLOCK - 1);
+	check(s.read() == NULL, "a block handed over before it was full");
+	clock(s, 1);
+	b = s.read();
+	check(b && consecutive(b, 0), "first block not handed over, or wrong samples");
+	check(s.read() == NULL, "the same block handed over twice");
+
+	// A reader that keeps up, i.e. is done with a block and calls read()
+	// again before the next one is full, gets every sample in order;
+	// clocked through the timer slot's callback this time
+	int8_t slot = sampleTimer.isAllocated_SIT();
+	check(slot >= 0 && IntervalTimer::SIT_CALLBACK[slot] != NULL, "no timer slot running the sampler");
+	bool inOrder = true;
+	for (int i = 1; i <= 100; i++) {
+		for (int j = 0; j < BLOCK; j++) {
+			IntervalTimer::SIT_CALLBACK[slot]();
+			if (j == BLOCK / 2)
+				inOrder &= s.read() == NULL;
+		}
+		b = s.read();
+		inOrder &= b && consecutive(b, i * BLOCK);
+	}
+	check(inOrder, "blocks lost or out of order with a reader that keeps up");
+	check(s.overruns() == 0, "overruns counted with a reader that keeps up");
+}
+
+static void testOverruns(AudioSampler &s)
+{
+	const uint16_t *b, *held;
+	uint16_t copy[BLOCK];
+
+	// Three blocks without reading: two are replaced, the newest is read
+	counter = 0;
+	s.end();
+	s.begin(RATE);
+	clock(s, 3 * BLOCK);
+	b = s.read();
+	check(b && consecutive(b, 2 * BLOCK), "not the newest block after two replacements");
+	check(s.overruns() == 2, "two replaced blocks not counted as two overruns");
+
+	// Hold a block while the other fills: sampling pauses, the held block
+	// stays as it was, and the block that filled is the next one read
+	counter = 0;
+	s.end();
+	s.begin(RATE);
+	clock(s, BLOCK);
+	held = s.read();
+	memcpy(copy, held, sizeof(copy));
+	clock(s, 10 * BLOCK);
+	check(memcmp(copy, held, sizeof(copy)) == 0, "the held block was written");
+	check(counter == 2 * BLOCK, "sampling did not pause while the reader held a block");
+	check(s.overruns() == 1, "a pause not counted as one overrun");
+	b = s.read();
+	check(b && b != held && consecutive(b, BLOCK), "the block filled before the pause not read next");
+	clock(s, BLOCK / 2);
+	check(s.read() == NULL, "a block handed over before it was full, after the pause");
+	clock(s, BLOCK / 2);
+	b = s.read();
+	check(b == held && consecutive(b, 2 * BLOCK), "sampling did not resume into the released block");
+	check(s.overruns() == 1, "overruns counted after resuming");
+
+	// Reading a block the moment it is full, without calling read() in
+	// between, means the reader still held the other one: each block
+	// read that way costs a pause
+	clock(s, BLOCK);
+	b = s.read();
+	check(b && consecutive(b, 3 * BLOCK) && s.overruns() == 2, "a pause at a full block not counted");
+
+	// release() while paused resumes into the released block at once,
+	// and the waiting block is still the next one read
+	clock(s, 2 * BLOCK);
+	check(counter == 5 * BLOCK && s.overruns() == 3, "no pause while holding a block");
+	s.release();
+	clock(s, BLOCK / 2);
+	check(counter == 5 * BLOCK + BLOCK / 2, "release() did not resume sampling");
+	b = s.read();
+	check(b && consecutive(b, 4 * BLOCK), "the block filled before the pause not read after release()");
+	s.release();
+	clock(s, BLOCK / 2);
+	b = s.read();
+	check(b && consecutive(b, 5 * BLOCK) && s.overruns() == 3, "a block lost after release()");
+}
+
+// Random interleaving of samples, reads and releases.  Each block read
+// must be consecutive and later than the one before, and the held block
+// must not change until it is released or the next read.  The tool keeps its own count of what
+// should be overruns: a block completed while an unread one was waiting
+// (which must show as a gap of a whole block in what is read), or while
+// the reader held the other one (a pause).
+static void testRandom(AudioSampler &s)
+{
+	const uint16_t *held = NULL;
+	uint16_t copy[BLOCK];
+	long     blocks = 0, replaced = 0, expected = 0, replacements = 0;
+	bool     ready = false;	// A full block is waiting to be read
+	uint32_t next = 0;	// First sample of the next block, not wrapped
+	uint32_t taken = 0;	// Samples the source has given, not wrapped
+	bool     ok = true;
+
+	counter = 0;
+	s.end();
+	s.begin(RATE);
+	srand(1);
+	for (long i = 0; i < RANDOM_STEPS && ok; i++) {
+		if (random(0, 4 * BLOCK)) {
+			uint16_t before = counter;
+			s.sample();
+			if (counter == before)
+				continue;	// Paused
+			taken++;
+			if (taken % BLOCK == 0) {	// A block is full
+				expected += ready + (held != NULL);
+				replacements += ready;
+				ready = true;
+			}
+			if (held && memcmp(copy, held, sizeof(copy))) {
+				printf("step %ld: the held block was written\n", i);
+				ok = false;
+			}
+			continue;
+		}
+		if (random(0, 2)) {
+			s.release();
+			held = NULL;
+			continue;
+		}
+		// read() releases the held block, whether or not it returns one
+		const uint16_t *b = s.read();
+		held = b;
+		ready = false;
+		if (!b)
+			continue;
+		uint32_t first = next;
+		while ((uint16_t)first != b[0] && first < taken)
+			first += BLOCK;
+		if (!consecutive(b, b[0]) || (uint16_t)first != b[0] || (first - next) % BLOCK) {
+			printf("step %ld: block from %u, expected %u or a whole block later\n",
+				i, b[0], (uint16_t)next);
+			ok = false;
+		}
+		replaced += (first - next) / BLOCK;
+		next = first + BLOCK;
+		blocks++;
+		memcpy(copy, held, sizeof(copy));
+	}
+	printf("random run: %ld blocks read, %ld replaced unread, %u overruns, %ld expected\n",
+		blocks, replaced, s.overruns(), expected);
+	check(ok, "random run");
+	check(blocks > 1000, "random run read too few blocks to mean anything");
+	check(replaced == replacements, "gaps in the blocks read don't match the blocks replaced");
+	check(s.overruns() == (uint16_t)expected, "overruns() in the random run");
+}
+
+// A reader like the sketch's: polls read() every SLOW_POLL_MS on the simulated
+// clock, copies the block and, if 'release', lets it go at once.  Returns
+// overruns() after SLOW_BLOCKS blocks' worth of time; 'lost' is false if
+// any block read was not the one after the last.
+static uint16_t slowReader(bool release, bool *lost)
+{
+	AudioSampler    slow(A0, SLOW_BLOCK);
+	const uint16_t *b;
+	uint16_t        copy[SLOW_BLOCK], next = 0;
+
+	*lost   = false;
+	counter = 0;
+	slow.setSource(countingSource);
+	slow.begin(RATE);
+	for (long ms = 0; ms < SLOW_BLOCKS * SLOW_BLOCK * 1000 / RATE; ms += SLOW_POLL_MS) {
+		delay(SLOW_POLL_MS);
+		if ((b = slow.read()) == NULL)
+			continue;
+		memcpy(copy, b, sizeof(copy));
+		if (release)
+			slow.release();
+		*lost |= !consecutive(copy, next, SLOW_BLOCK);
+		next = copy[0] + SLOW_BLOCK;
+	}
+	slow.end();
+	return slow.overruns();
+}
+
+static void testSlowReader(AudioSampler &s)
+{
+	uint16_t held, released;
+	bool     heldLost, releasedLost;
+
+	s.end();
+	held     = slowReader(false, &heldLost);
+	released = slowReader(true, &releasedLost);
+	printf("%ld blocks of %d at %d Hz, read every %d ms: %u overruns holding "
+		"each block until the next read(), %u with release()\n", SLOW_BLOCKS,
+		SLOW_BLOCK, RATE, SLOW_POLL_MS, held, released);
+	check(released == 0 && !releasedLost, "samples lost by a slow reader that calls release()");
+}
+
+static void testTimer(AudioSampler &s)
+{
+	int8_t   slot;
+	long     samples = 0;
+	uint32_t start, span;
+
+	counter = 0;
+	s.end();
+	s.begin(RATE);
+	start = micros();
+	slot = sampleTimer.isAllocated_SIT();
+	check(slot >= 0 && hostClock().timers[slot].period == 1000000UL / RATE,
+		"timer period not 1 / rate");
+
+	// One second of the simulated clock, reading every ms
+	for (int ms = 0; ms < 1000; ms++) {
+		delay(1);
+		if (s.read())
+			samples += BLOCK;
+	}
+	span = micros() - start;
+	printf("one second at %d Hz: %u samples taken, %ld read\n", RATE, counter, samples);
+	// The host's own time, the ISRs' included, moves the simulated clock
+	// on too: a sample more for every 1 / rate of it
+	check(counter >= RATE && counter <= (uint64_t)span * RATE / 1000000 + 1 &&
+		samples >= RATE / BLOCK * BLOCK, "one second of delay() did not give rate samples");
+
+	s.begin(RATE / 2);
+	check(hostClock().timers[slot].period == 2000000UL / RATE, "begin() did not change the rate");
+	s.end();
+	check(sampleTimer.isAllocated_SIT() < 0, "end() left the timer running");
+}
+
+int main(void)
+{
+	AudioSampler s(A0, BLOCK);
+
+	s.setSource(countingSource);
+	testHandoff(s);
+	testOverruns(s);
+	testRandom(s);
+	testSlowReader(s);
+	testTimer(s);
+	if (!failed)
+		printf("all checks passed\n");
+	return failed;
+}
@@ -0,0 +1,37 @@
+/*
+The whole firmware, libraries and sketch, in one translation unit for
+the host tools that run the clock's own modes (marqueebench, clockbench
+...).  Include it instead of the individual sources, then call the
+sketch's functions; setup() is not run, it waits for the cloud, so call
+sketchInit() instead.
+*/
+
+#ifndef _TOOLS_SKETCH_H
+#define _TOOLS_SKETCH_H
+
+#include "application.h"
+
+#include "../Adafruit_mfGFX.cpp"
+#include "../GFXcanvas.cpp"
+#include "../fonts.cpp"
+#include "hosttimer.cpp"
+#include "../RGBmatrixPanel.cpp"
+#include "../fixmath.cpp"
+#include "../fix_fft.cpp"
+#include "../spectrum.cpp"
+#include "../AudioSampler.cpp"
+#include "../AudioAnalyzer.cpp"
+#include "../Plasma.cpp"
+#include "../FramePacer.cpp"
+#include "../RGBPongClock.ino"
+
+// The display part of setup()
+inline void sketchInit(void)
+{
+	matrix.begin();
+	matrix.setTextWrap(false);
+	matrix.setTextSize(1);
+	matrix.setTextColor(matrix.Color333(210, 210, 210));
+}
+
+#endif
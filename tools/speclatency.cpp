@@ -0,0 +1,116 @@
+/*
+speclatency - how long a sound takes to reach the spectrum bars, and
+what each frame costs, for every hop (new samples per frame) the
+overlapped analysis supports.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o speclatency tools/speclatency.cpp && ./speclatency
+
+Each trial plays a second of quiet noise (so the auto-gain settles)
+and then a tone, starting at a different point relative to the block
+boundaries each time, through the same code spectrumDisplay() runs
+(SpectrumHistory, spectrumColumns(), SpectrumLevels).  The latency is
+the time from the first sample of the tone to the end of the block
+whose frame first shows the tone's column at half height or more;
+it includes waiting for the block to fill but not the time to draw
+it.  Frame times are host timings; compare hops with each other, not
+with the Core.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#include "../fixmath.cpp"
+#include "../fix_fft.cpp"
+#include "../spectrum.cpp"
+
+#define MIC_RATE	8000		// As in the sketch
+#define SETTLE		MIC_RATE	// Samples of noise before each tone
+#define TONE		(MIC_RATE / 2)	// Samples of tone
+#define OFFSETS		16		// Tone starts per frequency
+
+static const int hops[] = { 128, 64, 32 };
+static const int tones[] = { 250, 500, 1000, 2000, 3000 };
+
+int main(void)
+{
+	uint16_t edges[SPECTRUM_COLUMNS + 1];
+
+	spectrumLogMap(edges, SPECTRUM_COLUMNS, 1, SPECTRUM_POINTS / 2);
+	srand(1);
+
+	printf("%4s  %16s  %16s  %12s  %14s\n", "hop", "mean latency",
+		"max latency", "ns/frame", "frames/s");
+
+	for (size_t h = 0; h < sizeof(hops) / sizeof(hops[0]); h++) {
+		int    hop = hops[h];
+		double latencySum = 0, latencyMax = 0, ns = 0;
+		long   trials = 0, frames = 0, missed = 0;
+
+		for (size_t t = 0; t < sizeof(tones) / sizeof(tones[0]); t++) {
+			// Column showing the tone
+			int bin = (tones[t] * SPECTRUM_POINTS + MIC_RATE / 2) / MIC_RATE, col = 0;
+			while (col < SPECTRUM_COLUMNS - 1 && edges[col + 1] <= bin)
+				col++;
+
+			for (int o = 0; o < OFFSETS; o++) {
+				long start = SETTLE + o * SPECTRUM_POINTS / OFFSETS, found = -1;
+				std::vector<uint16_t> adc(start + TONE);
+
+				for (long i = 0; i < (long)adc.size(); i++) {
+					double v = (rand() % 65 - 32) / 2048.0;
+					if (i >= start)
+						v += 0.5 * sin(2 * M_PI * tones[t] * (i - start) / MIC_RATE);
+					adc[i] = 2048 + (long)floor(v * 2047 + 0.5);
+				}
+
+				SpectrumHistory history;
+				SpectrumLevels  levels;
+				int16_t         fftdata[SPECTRUM_POINTS], spectrum[SPECTRUM_COLUMNS];
+				levels.setHop(hop);
+
+				for (long b = 0; b + hop <= (long)adc.size() && found < 0; b += hop) {
+					std::chrono::steady_clock::time_point t0 =
+						std::chrono::steady_clock::now();
+
+					history.add(&adc[b], hop);
+					if (!history.full())
+						continue;
+					history.magnitudes(fftdata, WINDOW_HANN);
+					spectrumColumns(fftdata, edges, SPECTRUM_COLUMNS, spectrum);
+					levels.update(spectrum);
+
+					ns += std::chrono::duration<double, std::nano>(
+						std::chrono::steady_clock::now() - t0).count();
+					frames++;
+
+					if (b + hop > start && levels.height(col) >= SPECTRUM_ROWS / 2)
+						found = b + hop;
+				}
+
+				if (found < 0) {
+					missed++;
+					continue;
+				}
+				double ms = (found - start) * 1000.0 / MIC_RATE;
+				latencySum += ms;
+				if (ms > latencyMax)
+					latencyMax = ms;
+				trials++;
+			}
+		}
+
+		printf("%4d  %13.1f ms  %13.1f ms  %12.0f  %14.1f", hop,
+			trials ? latencySum / trials : 0, latencyMax, ns / frames,
+			(double)MIC_RATE / hop);
+		if (missed)
+			printf("  (%ld tones never shown)", missed);
+		printf("\n");
+	}
+	return 0;
+}
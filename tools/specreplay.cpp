@@ -0,0 +1,288 @@
+/*
+specreplay - run recorded audio through the spectrum display pipeline
+(SpectrumHistory or SpectrumGoertzel, spectrumColumns(), SpectrumLevels
+from spectrum.cpp) and write the frames the panel would show as images.
+
+This is a host tool, it is not part of the firmware.  Build it from the
+repository root:
+
+	g++ -O2 -Itools -o specreplay tools/specreplay.cpp
+
+Usage:
+
+	specreplay [options] recording.wav
+	specreplay [options] -r rate recording.raw
+
+Options:
+	-r rate		sample rate of a raw recording (default 8000)
+	-m rate		microphone sample rate to replay at (default 8000,
+			MIC_RATE in the sketch)
+	-w window	none, hann, hamming or blackman (default hann)
+	-h hop		new samples per frame: 32, 64 or 128 (default 64,
+			SPECTRUM_HOP in the sketch)
+	-b bands	bands to show (default 32); up to 8 use Goertzel
+			filters, a frame per 128 samples, like the sketch
+	-o prefix	write each frame to prefix00000.ppm, prefix00001.ppm ...
+	-s scale	pixels per LED in the images (default 8)
+	-q		only print the summary, not every frame's time
+
+WAV files may be 8 or 16 bit PCM, mono or stereo (mixed down); raw
+files are signed 16 bit little endian mono.  The audio is resampled to
+the microphone rate and quantized like the 12 bit ADC, then cut into
+blocks of hop samples, as AudioSampler hands them to spectrumDisplay();
+there is a frame per block once the first SPECTRUM_POINTS samples are
+in.
+
+The time printed for each frame covers the pipeline only (window, FFT,
+magnitudes, column map and levels), not the drawing.  Host timings;
+compare them between builds of the pipeline, not with the Core.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include "../fixmath.cpp"
+#include "../fix_fft.cpp"
+#include "../spectrum.cpp"
+
+static void die(const char *msg, const char *arg = "")
+{
+	fprintf(stderr, "specreplay: %s%s\n", msg, arg);
+	exit(1);
+}
+
+static uint32_t le32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t le16(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+// Audio as doubles in -1 .. 1, mono; returns the sample rate (0 if
+// 'data' is not a WAV file)
+static long readWav(const std::vector<uint8_t> &data, std::vector<double> &audio)
+{
+	const uint8_t *fmt = NULL;
+	size_t pos = 12;
+
+	if (data.size() < 12 || memcmp(&data[0], "RIFF", 4) ||
+		memcmp(&data[8], "WAVE", 4))
+		return 0;
+
+	while (pos + 8 <= data.size()) {
+		uint32_t size = le32(&data[pos + 4]);
+		const uint8_t *body = &data[pos + 8];
+
+		if (size > data.size() - pos - 8)
+			size = data.size() - pos - 8;	// Truncated recording
+		if (!memcmp(&data[pos], "fmt ", 4) && size >= 16)
+			fmt = body;
+		else if (!memcmp(&data[pos], "data", 4)) {
+			if (!fmt)
+				die("WAV data before its format");
+			int channels = le16(fmt + 2), bits = le16(fmt + 14);
+			if (le16(fmt) != 1 || (bits != 8 && bits != 16) || channels < 1)
+				die("only 8 and 16 bit PCM WAV files are supported");
+			size_t frame = channels * bits / 8;
+			for (size_t i = 0; i + frame <= size; i += frame) {
+				double sum = 0;
+				for (int c = 0; c < channels; c++)
+					sum += (bits == 8) ? (body[i + c] - 128) / 128.0 :
+						(int16_t)le16(body + i + 2 * c) / 32768.0;
+				audio.push_back(sum / channels);
+			}
+			return le32(fmt + 4);
+		}
+		pos += 8 + size + (size & 1);
+	}
+	die("no data in the WAV file");
+	return 0;
+}
+
+static void writeFrame(const char *prefix, long n, int scale,
+	SpectrumLevels &levels)
+{
+	uint8_t rgb[SPECTRUM_ROWS][SPECTRUM_COLUMNS][3];
+	char    name[1024];
+	FILE   *f;
+
+	// As spectrumDisplay() draws it: the gradient, blanked above each
+	// column, and the peak dot (Color444() keeps the low 4 bits)
+	for (int y = 0; y < SPECTRUM_ROWS; y++)
+		for (int x = 0; x < SPECTRUM_COLUMNS; x++) {
+			int c = levels.height(x), p = levels.peak(x), r, b;
+			if (p > 0 && y == SPECTRUM_ROWS - p) {
+				r = p;
+				b = SPECTRUM_ROWS - p;
+			}
+			else if (p <= 0 || (c < SPECTRUM_ROWS - 1 && y <= SPECTRUM_ROWS - 1 - c))
+				r = b = 0;
+			else {
+				r = SPECTRUM_ROWS - y;
+				b = y;
+			}
+			rgb[y][x][0] = (r & 15) * 17;
+			rgb[y][x][1] = 0;
+			rgb[y][x][2] = (b & 15) * 17;
+		}
+
+	snprintf(name, sizeof(name), "%s%05ld.ppm", prefix, n);
+	if (!(f = fopen(name, "wb")))
+		die("can't write ", name);
+	fprintf(f, "P6\n%d %d\n255\n", SPECTRUM_COLUMNS * scale,
+		SPECTRUM_ROWS * scale);
+	for (int y = 0; y < SPECTRUM_ROWS * scale; y++)
+		for (int x = 0; x < SPECTRUM_COLUMNS * scale; x++)
+			fwrite(rgb[y / scale][x / scale], 3, 1, f);
+	fclose(f);
+}
+
+int main(int argc, char **argv)
+{
+	const char *input = NULL, *prefix = NULL;
+	long rawRate = 8000, micRate = 8000, rate;
+	int scale = 8, window = WINDOW_HANN, hop = 64, bands = SPECTRUM_COLUMNS;
+	bool quiet = false, usage = false;
+
+	for (int i = 1; i < argc; i++) {
+		const char *a = argv[i];
+		if (!strcmp(a, "-r") && i + 1 < argc)
+			rawRate = atol(argv[++i]);
+		else if (!strcmp(a, "-m") && i + 1 < argc)
+			micRate = atol(argv[++i]);
+		else if (!strcmp(a, "-w") && i + 1 < argc) {
+			static const char *names[NUM_WINDOWS] =
+				{ "none", "hann", "hamming", "blackman" };
+			for (window = 0; window < NUM_WINDOWS; window++)
+				if (!strcmp(argv[i + 1], names[window]))
+					break;
+			if (window == NUM_WINDOWS)
+				die("unknown window ", argv[i + 1]);
+			i++;
+		}
+		else if (!strcmp(a, "-h") && i + 1 < argc)
+			hop = atoi(argv[++i]);
+		else if (!strcmp(a, "-b") && i + 1 < argc)
+			bands = atoi(argv[++i]);
+		else if (!strcmp(a, "-o") && i + 1 < argc)
+			prefix = argv[++i];
+		else if (!strcmp(a, "-s") && i + 1 < argc)
+			scale = atoi(argv[++i]);
+		else if (!strcmp(a, "-q"))
+			quiet = true;
+		else if (a[0] != '-' && !input)
+			input = a;
+		else
+			usage = true;
+	}
+	if (usage || !input || rawRate <= 0 || micRate <= 0 || scale < 1 ||
+		hop < 1 || hop > SPECTRUM_POINTS || SPECTRUM_POINTS % hop ||
+		bands < 1 || bands > SPECTRUM_COLUMNS)
+		die("usage: specreplay [-r rate] [-m rate] "
+			"[-w none|hann|hamming|blackman] [-h 32|64|128] [-b bands] [-o prefix] "
+			"[-s scale] [-q] "
+			"recording.wav|recording.raw");
+
+	// Read the recording
+	std::vector<uint8_t> data;
+	std::vector<double>  audio;
+	FILE *f = fopen(input, "rb");
+	if (!f)
+		die("can't open ", input);
+	uint8_t buf[4096];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		data.insert(data.end(), buf, buf + n);
+	fclose(f);
+
+	if (!(rate = readWav(data, audio))) {
+		rate = rawRate;
+		for (size_t i = 0; i + 1 < data.size(); i += 2)
+			audio.push_back((int16_t)le16(&data[i]) / 32768.0);
+	}
+	if (audio.empty())
+		die("no audio in ", input);
+
+	// Resample (linear) to the microphone rate and quantize like the ADC
+	std::vector<uint16_t> adc;
+	for (double t = 0; t < audio.size() - 1; t += (double)rate / micRate) {
+		size_t i = (size_t)t;
+		double v = audio[i] + (audio[i + 1] - audio[i]) * (t - i);
+		long   s = 2048 + (long)(v * 2048 + (v < 0 ? -0.5 : 0.5));
+		adc.push_back(s < 0 ? 0 : s > 4095 ? 4095 : s);
+	}
+
+	uint16_t         edges[SPECTRUM_COLUMNS + 1];
+	int16_t          fftdata[SPECTRUM_POINTS], spectrum[SPECTRUM_COLUMNS];
+	SpectrumHistory  history;
+	SpectrumGoertzel filters;
+	SpectrumLevels   levels;
+	bool             goertzel = bands <= SPECTRUM_GOERTZEL_MAX;
+	long             blocks = adc.size() / hop, frames = 0;
+	double           total = 0, slowest = 0, fastest = 1e30, pending = 0;
+
+	if (goertzel) {
+		filters.begin(bands, micRate);
+		levels.setHop(SPECTRUM_POINTS);
+	}
+	else {
+		spectrumLogMap(edges, bands, 1, SPECTRUM_POINTS / 2);
+		levels.setHop(hop);
+	}
+
+	if (!quiet)
+		printf("%6s  %9s\n", "frame", "ns");
+	for (long b = 0; b < blocks; b++) {
+		std::chrono::steady_clock::time_point start =
+			std::chrono::steady_clock::now();
+		bool frame;
+
+		if (goertzel) {
+			if ((frame = filters.add(&adc[b * hop], hop)))
+				filters.levels(spectrum);
+		}
+		else {
+			history.add(&adc[b * hop], hop);
+			if ((frame = history.full())) {
+				history.magnitudes(fftdata, window);
+				spectrumColumns(fftdata, edges, bands, spectrum);
+			}
+		}
+		if (frame) {
+			spectrumSpread(spectrum, bands);
+			levels.update(spectrum);
+		}
+
+		// Blocks that don't make a frame (the Goertzel filters run on
+		// every sample) count towards the next one
+		pending += std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - start).count();
+		if (!frame)
+			continue;
+		double ns = pending;
+		pending = 0;
+		total += ns;
+		if (ns > slowest) slowest = ns;
+		if (ns < fastest) fastest = ns;
+
+		if (!quiet)
+			printf("%6ld  %9.0f\n", frames, ns);
+		if (prefix)
+			writeFrame(prefix, frames, scale, levels);
+		frames++;
+	}
+
+	if (!frames)
+		die("recording is shorter than one transform");
+	printf("%ld frames of %d bands (%s) at %ld Hz (%.2f s): "
+		"%.0f ns mean, %.0f min, %.0f max per frame\n",
+		frames, bands, goertzel ? "Goertzel" : "FFT", micRate, (double)adc.size() / micRate,
+		total / frames, fastest, slowest);
+	return 0;
+}
@@ -0,0 +1,268 @@
+/*
+statstest - RollingStats against a brute-force window, and the
+auto-gain SpectrumLevels builds on it.
+
+This is a host tool, it is not part of the firmware.  Build and run it
+from the repository root:
+
+	g++ -O2 -Itools -o statstest tools/statstest.cpp && ./statstest
+
+RollingStats is fed random values, random walks, rising and falling
+ramps (where its queues grow longest or empty fastest) and long runs of
+one value, at several types and window lengths, with a reset() now and
+then.  After every push lowest(), highest(), total(), average() and
+size() must equal what a scan of the last N values gives, including
+while the window is still filling.
+
+SpectrumLevels is fed generated audio through the same code
+spectrumDisplay() runs (SpectrumHistory, spectrumColumns()): quiet
+noise and a tone that is loud for SWELL blocks, then a quarter as loud
+for as many.  At each volume, once settled, the tone's column must
+reach 3/4 height or more when loud and stay at 1/4 or less when soft;
+after a step from one volume to another it must settle the same way
+within SETTLE_MAX blocks.  A tone too quiet to span the minimum range
+of 8 levels must not be blown up past half height, and silence must
+take every column and peak dot down to 0.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../fixmath.cpp"
+#include "../fix_fft.cpp"
+#include "../spectrum.cpp"
+
+#define PUSHES		20000		// Per signal, type and window length
+#define MIC_RATE	8000		// As in the sketch
+#define TONE		1000		// Hz
+#define QUIET		0.05		// Of full scale, levels 0 - 3
+#define SWELL		8		// Blocks loud, then as many soft
+#define SETTLE		(16 * SWELL)	// Blocks before heights are checked
+#define SETTLE_MAX	(6 * SWELL)	// Blocks allowed to settle after a step
+
+static int failed;
+
+static void check(bool ok, const char *what)
+{
+	if (!ok) {
+		printf("FAIL: %s\n", what);
+		failed = 1;
+	}
+}
+
+enum { RANDOM, WALK, RISING, FALLING, RUNS, SIGNALS };
+static const char *signalNames[SIGNALS] = { "random", "walk", "rising", "falling", "runs" };
+
+// Next value of a test signal between lo and hi
+static long nextValue(int signal, long i, long prev, long lo, long hi)
+{
+	long v;
+
+	switch (signal) {
+	case RANDOM:
+		return random(lo, hi + 1);
+	case WALK:
+		v = prev + random(-3, 4);
+		return v < lo ? lo : v > hi ? hi : v;
+	case RISING:
+		return lo + i % (hi - lo + 1);
+	case FALLING:
+		return hi - i % (hi - lo + 1);
+	default:
+		return (i / 50) & 1 ? prev : random(lo, hi + 1);
+	}
+}
+
+template<class T, uint8_t N> static void testWindow(const char *type, long lo, long hi)
+{
+	for (int signal = 0; signal < SIGNALS; signal++) {
+		RollingStats<T, N> stats;
+		T     window[PUSHES];
+		long  first = 0, v = (lo + hi) / 2, bad = -1;
+
+		for (long i = 0; i < PUSHES && bad < 0; i++) {
+			// Start over now and then, and check the empty window
+			if (i % 7919 == 7918) {
+				stats.reset();
+				first = i;
+				if (stats.size() || stats.lowest() || stats.highest() ||
+					stats.total() || stats.average())
+					bad = i;
+			}
+			v = nextValue(signal, i, v, lo, hi);
+			window[i] = (T)v;
+			stats.push((T)v);
+
+			long from = i + 1 - N > first ? i + 1 - N : first;
+			T    low = window[from], high = window[from];
+			long sum = 0;
+			for (long j = from; j <= i; j++) {
+				if (window[j] < low)
+					low = window[j];
+				if (window[j] > high)
+					high = window[j];
+				sum += window[j];
+			}
+			uint8_t n = i + 1 - from;
+			if (stats.size() != n || stats.lowest() != low || stats.highest() != high ||
+				stats.total() != sum || stats.average() != (T)(sum / n))
+				bad = i;
+		}
+		if (bad >= 0) {
+			printf("RollingStats<%s, %d>, %s values: wrong after push %ld\n",
+				type, N, signalNames[signal], bad);
+			failed = 1;
+		}
+	}
+	printf("RollingStats<%s, %d>: %d pushes of each signal\n", type, N, PUSHES);
+}
+
+// One block of the tone at amplitude amp (of full scale), or silence,
+// over quiet noise
+static void makeBlock(uint16_t adc[], long block, double amp, bool quiet)
+{
+	for (int i = 0; i < SPECTRUM_POINTS; i++) {
+		long   t = block * SPECTRUM_POINTS + i;
+		double v = quiet ? 0 : (rand() % 65 - 32) / 2048.0;
+		v += amp * sin(2 * M_PI * TONE * t / MIC_RATE);
+		adc[i] = 2048 + (long)floor(v * 2047 + 0.5);
+	}
+}
+
+static bool loud(long block)
+{
+	return block / SWELL % 2 == 0;
+}
+
+struct Feed {
+	SpectrumHistory history;
+	SpectrumLevels  levels;
+	uint16_t        edges[SPECTRUM_COLUMNS + 1];
+	long            block;
+
+	Feed(void) : block(0) {
+		spectrumLogMap(edges, SPECTRUM_COLUMNS, 1, SPECTRUM_POINTS / 2);
+	}
+
+	// One block at volume amp; amp 0 is silence, with no noise either
+	void next(double amp) {
+		uint16_t adc[SPECTRUM_POINTS];
+		int16_t  fftdata[SPECTRUM_POINTS], spectrum[SPECTRUM_COLUMNS];
+
+		makeBlock(adc, block, loud(block) ? amp : amp / 4, amp == 0);
+		history.add(adc, SPECTRUM_POINTS);
+		history.magnitudes(fftdata, WINDOW_HANN);
+		spectrumColumns(fftdata, edges, SPECTRUM_COLUMNS, spectrum);
+		levels.update(spectrum);
+		block++;
+	}
+};
+
+// Lowest height in loud blocks and highest in soft ones, over a whole
+// number of swells
+static void swing(Feed &f, double amp, int col, int &loudLow, int &softHigh)
+{
+	loudLow  = SPECTRUM_ROWS + 2;
+	softHigh = 0;
+	for (int b = 0; b < 4 * SWELL; b++) {
+		bool l = loud(f.block);
+		f.next(amp);
+		int h = f.levels.height(col);
+		if (l && h < loudLow)
+			loudLow = h;
+		if (!l && h > softHigh)
+			softHigh = h;
+	}
+}
+
+static void testAutoGain(void)
+{
+	static const double volumes[] = { 0.2, 0.4, 0.8 };
+	uint16_t edges[SPECTRUM_COLUMNS + 1];
+	int      bin = (TONE * SPECTRUM_POINTS + MIC_RATE / 2) / MIC_RATE, col = 0;
+	int      loudLow, softHigh;
+	char     what[80];
+
+	spectrumLogMap(edges, SPECTRUM_COLUMNS, 1, SPECTRUM_POINTS / 2);
+	while (col < SPECTRUM_COLUMNS - 1 && edges[col + 1] <= bin)
+		col++;
+
+	printf("\n%d Hz tone in column %d, %d blocks loud then %d at 1/4\n",
+		TONE, col, SWELL, SWELL);
+	printf("%-8s  %16s  %16s\n", "volume", "lowest if loud", "highest if soft");
+	srand(1);
+	for (size_t v = 0; v < sizeof(volumes) / sizeof(volumes[0]); v++) {
+		Feed f;
+		while (f.block < SETTLE)
+			f.next(volumes[v]);
+		swing(f, volumes[v], col, loudLow, softHigh);
+		printf("%-8.2f  %16d  %16d\n", volumes[v], loudLow, softHigh);
+		snprintf(what, sizeof(what), "heights not settled at volume %.2f", volumes[v]);
+		// Loud blocks at least 3/4 up, soft ones at most 1/4
+		check(loudLow >= SPECTRUM_ROWS * 3 / 4 && softHigh <= SPECTRUM_ROWS / 4, what);
+	}
+
+	// Steps between those volumes: the blocks until every later one is
+	// as settled as above
+	printf("\n%-12s  %16s\n", "step", "blocks to settle");
+	for (size_t i = 0; i < sizeof(volumes) / sizeof(volumes[0]); i++)
+		for (size_t j = 0; j < sizeof(volumes) / sizeof(volumes[0]); j++) {
+			double from = volumes[i], to = volumes[j];
+			Feed   f;
+			long   blocks = 0;
+
+			if (i == j)
+				continue;
+			while (f.block < SETTLE)
+				f.next(from);
+			for (long b = 1; b <= 4 * SETTLE_MAX; b++) {
+				bool l = loud(f.block);
+				f.next(to);
+				int h = f.levels.height(col);
+				if (l ? h < SPECTRUM_ROWS * 3 / 4 : h > SPECTRUM_ROWS / 4)
+					blocks = b;
+			}
+			printf("%.2f - %.2f   %16ld\n", from, to, blocks);
+			snprintf(what, sizeof(what), "step from %.2f to %.2f did not settle", from, to);
+			check(blocks <= SETTLE_MAX, what);
+		}
+
+	// A tone too quiet to span 8 levels is not blown up to full height:
+	// SpectrumLevels keeps a minimum range so the bars don't jump
+	Feed quiet;
+	int  highest = 0;
+	while (quiet.block < SETTLE + 4 * SWELL) {
+		quiet.next(QUIET);
+		if (quiet.block > SETTLE && quiet.levels.height(col) > highest)
+			highest = quiet.levels.height(col);
+	}
+	printf("\nvolume %.2f: at most %d high\n", QUIET, highest);
+	check(highest <= SPECTRUM_ROWS / 2, "a quiet tone blown up to full height");
+
+	// Silence after sound: everything goes down to 0
+	Feed f;
+	while (f.block < SETTLE)
+		f.next(volumes[1]);
+	for (int b = 0; b < SETTLE; b++)
+		f.next(0);
+	bool zero = true;
+	for (int c = 0; c < SPECTRUM_COLUMNS; c++)
+		zero &= f.levels.height(c) == 0 && f.levels.peak(c) == 0;
+	check(zero, "silence does not take the bars and peaks to 0");
+}
+
+int main(void)
+{
+	srand(1);
+	testWindow<int8_t, 10>("int8_t", -128, 127);
+	testWindow<int8_t, 1>("int8_t", -128, 127);
+	testWindow<uint8_t, 2>("uint8_t", 0, 255);
+	testWindow<uint8_t, 37>("uint8_t", 0, 255);
+	testWindow<int16_t, 128>("int16_t", -32768, 32767);
+	testWindow<uint16_t, 100>("uint16_t", 0, 65535);
+	testAutoGain();
+	if (!failed)
+		printf("all checks passed\n");
+	return failed;
+}
@@ -0,0 +1,92 @@
+#ifndef _WINDOW_H_
+#define _WINDOW_H_
+
+#include "application.h"
+#include "gamma.h"		// gammagen::MakeSeq
+
+/*
+ FFT window tables, generated by the compiler like the gamma tables.
+
+   WindowTable<T, Shape, N>::table[N]
+
+ holds the periodic (DFT-even) window of length N, in Q7 for
+ T = int8_t (the 8-bit fix_fft()) or Q15 for T = int16_t.  Multiply
+ each sample by its entry as it is stored, before the transform:
+
+   f[i] = (sample * table[i]) >> 7  (or >> 15)
+
+ A window trades a slightly wider peak for much less leakage into
+ far away bins; a rectangular window (no table) leaks a loud bin
+ into every column of a spectrum display.  All windows also lower
+ the level, by about half (see WINDOW_GAIN_SHIFT).
+
+ Only the tables that are used end up in flash.
+*/
+
+#define WINDOW_RECTANGULAR	0	// No window
+#define WINDOW_HANN			1	// Good all-round choice
+#define WINDOW_HAMMING		2	// Narrower peak, more distant leakage
+#define WINDOW_BLACKMAN		3	// Least leakage, widest peak
+#define NUM_WINDOWS			4
+
+// Shifting a windowed transform left by this restores roughly the
+// level of the unwindowed one (coherent gain 0.42 - 0.54)
+#define WINDOW_GAIN_SHIFT	1
+
+namespace windowgen {
+
+constexpr double PI2 = 6.28318530717958648;
+
+constexpr double cosSeries(double x2, double term, int n) {
+	return n > 15 ? 0 : term + cosSeries(x2, -term * x2 / ((2 * n + 1) * (2 * n + 2)), n + 1);
+}
+// cos(x) for 0 <= x < 2 * PI2, brought into [-pi, pi] first
+constexpr double cos(double x) {
+	return x > PI2 / 2 ? cos(x - PI2) : cosSeries(x * x, 1.0, 0);
+}
+
+constexpr double window(int shape, int i, int n) {
+	return shape == WINDOW_HANN     ? 0.5  - 0.5  * cos(PI2 * i / n) :
+	       shape == WINDOW_HAMMING  ? 0.54 - 0.46 * cos(PI2 * i / n) :
+	       shape == WINDOW_BLACKMAN ? 0.42 - 0.5  * cos(PI2 * i / n) +
+	                                  0.08 * cos(2 * PI2 * i / n) :
+	       1.0;
+}
+
+// Round to Q7 / Q15, 1.0 saturating to the largest value
+template<class T> constexpr T fixed(double w) {
+	return (T)(w * ((sizeof(T) == 1) ? 127 : 32767) + 0.5);
+}
+
+template<class T, int Shape, int N, class S> struct Table;
+template<class T, int Shape, int N, int... I>
+struct Table<T, Shape, N, gammagen::Seq<I...> > {
+	static const T table[N];
+};
+template<class T, int Shape, int N, int... I>
+const T Table<T, Shape, N, gammagen::Seq<I...> >::table[N] =
+	{ fixed<T>(window(Shape, I, N))... };
+
+}	// namespace windowgen
+
+template<class T, int Shape, int N>
+struct WindowTable : windowgen::Table<T, Shape, N, typename gammagen::MakeSeq<N>::type> {
+	static_assert(sizeof(T) == 1 || sizeof(T) == 2, "windows are Q7 or Q15");
+	static_assert(Shape > WINDOW_RECTANGULAR && Shape < NUM_WINDOWS, "unknown window");
+};
+
+/*
+ windowTable() - the table for a window picked at run time, or
+ NULL for WINDOW_RECTANGULAR (or anything unknown): leave the
+ samples as they are.
+*/
+template<class T, int N> const T *windowTable(uint8_t shape) {
+	switch (shape) {
+	case WINDOW_HANN:     return WindowTable<T, WINDOW_HANN, N>::table;
+	case WINDOW_HAMMING:  return WindowTable<T, WINDOW_HAMMING, N>::table;
+	case WINDOW_BLACKMAN: return WindowTable<T, WINDOW_BLACKMAN, N>::table;
+	default:              return NULL;
+	}
+}
+
+#endif // _WINDOW_H_